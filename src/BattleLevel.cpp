@@ -28,11 +28,11 @@ BattleLevel::BattleLevel(FPSUtility &fpsUtility_, std::string filename_) :
     m_fileName{std::move(filename_)},
     m_camera({0, 0}, gamedata::global::maxCameraSize, m_size),
     m_playerSystem(m_registry, m_partsys, m_camera),
-    m_rendersys(m_registry, m_camera, m_cldRoutesCollection),
+    m_rendersys(m_registry, m_camera, m_cldRoutesCollection, m_partsys),
     m_inputsys(m_registry),
     m_physsys(m_registry),
     m_camsys(m_registry, m_camera, m_playerSystem),
-    m_hudsys(m_registry, m_camera, m_levelName, m_size, m_playerSystem),
+    m_hudsys(m_registry, m_camera, m_levelName, m_size, m_playerSystem, m_rendersys),
     m_enemysys(m_registry, m_navsys, m_camera, m_partsys, m_playerSystem),
     m_aisys(m_registry),
     m_navsys(m_registry, m_graph),
@@ -56,6 +56,7 @@ void BattleLevel::enter()
     Level::enter();
 
     m_lvlBuilder.buildLevel(m_fileName, m_graph, m_cldRoutesCollection);
+    m_envSystem.buildIndex();
     m_playerSystem.createPlayer();
 
     m_camera.setScale(1.0f);
@@ -96,41 +97,65 @@ void BattleLevel::update()
 {
     PROFILE_FUNCTION;
 
-    m_physsys.prepHitstop();
-
-    m_inputsys.update();
-
-    m_rendersys.update();
-
-    m_navsys.update();
+    {
+        PROFILE_SYSTEM("Input");
+        m_physsys.prepHitstop();
+        m_inputsys.update();
+    }
 
-    m_aisys.update();
+    {
+        PROFILE_SYSTEM("Render update");
+        m_rendersys.update();
+    }
 
-    m_playerSystem.update();
+    {
+        PROFILE_SYSTEM("Navigation and AI");
+        m_navsys.update();
+        m_aisys.update();
+    }
 
-    m_physsys.prepEntities();
+    {
+        PROFILE_SYSTEM("Player");
+        m_playerSystem.update();
+    }
 
-    m_colsys.updateMovingColliders();
+    {
+        PROFILE_SYSTEM("Colliders");
+        m_physsys.prepEntities();
+        m_colsys.updateMovingColliders();
+    }
 
-    m_partsys.update();
+    {
+        PROFILE_SYSTEM("Particles");
+        m_partsys.update();
+    }
 
-    m_physsys.updatePhysics();
+    {
+        PROFILE_SYSTEM("Physics");
+        m_physsys.updatePhysics();
+    }
     
-    m_battlesys.update();
-    m_battlesys.handleAttacks();
-
-    m_envSystem.update();
-
-    m_camsys.update();
-
-    m_chatBoxSys.update();
+    {
+        PROFILE_SYSTEM("Battle");
+        m_battlesys.update();
+        m_battlesys.handleAttacks();
+    }
 
-    /*
-        Just updates camera shake logic, but many systems can cause shake
-    */
-    m_camera.update();
+    {
+        PROFILE_SYSTEM("Environment");
+        m_envSystem.update();
+    }
 
-    m_rendersys.updateDepth();
+    {
+        PROFILE_SYSTEM("Camera and chat");
+        m_camsys.update();
+        m_chatBoxSys.update();
+
+        /*
+            Just updates camera shake logic, but many systems can cause shake
+        */
+        m_camera.update();
+    }
 }
 
 void BattleLevel::draw() const
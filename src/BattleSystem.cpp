@@ -3,6 +3,7 @@
 #include "SM/StateMachine.h"
 #include "Core/Profile.h"
 #include "Core/Application.h"
+#include <algorithm>
 
 BattleSystem::BattleSystem(entt::registry &reg_, Camera &cam_) :
     m_reg(reg_),
@@ -12,58 +13,50 @@ BattleSystem::BattleSystem(entt::registry &reg_, Camera &cam_) :
 
 void BattleSystem::update()
 {
-    // TODO:
-    /*auto viewBtl = m_reg.view<BattleActor, StateMachine>();
-    std::set<uint32_t> newPresentHits;
+    PROFILE_FUNCTION;
+
+    auto viewBtl = m_reg.view<BattleActor, StateMachine>();
+    m_newPresentHits.clear();
 
     for (auto [idx, btl, sm] : viewBtl.each())
     {
-        dynamic_cast<PhysicalState*>(sm.getRealCurrentState())->updateActor(btl);
-        for (const auto &atk : btl.m_activeHits)
-            newPresentHits.insert(atk->m_hitData.m_id);
+        // TODO:
+        //dynamic_cast<PhysicalState*>(sm.getRealCurrentState())->updateActor(btl);
+        for (const auto *atk : btl.m_activeHits)
+            m_newPresentHits.push_back(atk->m_hitData.m_id.tag());
     }
 
-    for (const auto &id : m_presentHits)
+    // Retiring a hit that ended makes it stale in every actor at once, so the next instance can land again
+    std::sort(m_newPresentHits.begin(), m_newPresentHits.end(), [](const HitTag &lhs_, const HitTag &rhs_) { return lhs_.m_slot < rhs_.m_slot; });
+    for (const auto &tag : m_presentHits)
     {
-        if (!newPresentHits.contains(id))
-        {
-            for (auto [idx, btl, sm] : viewBtl.each())
-                btl.m_appliedHits.erase(id);
-        }
+        const auto found = std::lower_bound(m_newPresentHits.begin(), m_newPresentHits.end(), tag, [](const HitTag &lhs_, const HitTag &rhs_) { return lhs_.m_slot < rhs_.m_slot; });
+        if (found == m_newPresentHits.end() || *found != tag)
+            HitRegistry::instance().retire(tag);
     }
 
-    m_presentHits = std::move(newPresentHits);*/
+    std::swap(m_presentHits, m_newPresentHits);
 }
 
 void BattleSystem::handleAttacks()
 {
-    /*auto viewBtl = m_reg.view<BattleActor, StateMachine, ComponentTransform>();
-    for (auto [idx, btl, sm, trans] : viewBtl.each())
+    PROFILE_FUNCTION;
+
+    m_hitDetector.collect(m_reg);
+
+    /*
+        Every detected hit is applied, so trades land on both sides regardless of the order actors are stored in
+        applyHit doesn't interrupt attacks, if hitstun ever does, the winner of a trade has to be decided before detect() marks hits as applied
+    */
+    for (const auto &hit : m_hitDetector.detect())
     {
-        for (auto *atk : btl.m_activeHits)
-        {
-            for (auto [idxVic, btlVic, smVic, transVic] : viewBtl.each())
-            {
-                if (idx == idxVic || atk->m_hitData.m_friendTeams.contains(btlVic.m_team))
-                    continue;
-
-                if (btlVic.m_appliedHits.contains(atk->m_hitData.m_id))
-                    continue;
-
-                for (const auto &hurtGroup : *btlVic.m_hurtboxes)
-                {
-                    auto hitidef = detectHit(atk->m_colliders, btl.m_currentFrame, trans, hurtGroup.m_colliders, btlVic.m_currentFrame, transVic);
-                    if (hitidef.m_hitOccured)
-                    {
-                        btlVic.m_appliedHits.insert(atk->m_hitData.m_id);
-                        m_appliedHits.push(hitidef.m_hitPos);
-                        applyHit({idx, btl, sm, trans}, {idxVic, btlVic, smVic, transVic}, *atk);
-                        break;
-                    }
-                }
-            }
-        }
-    }*/
+        auto attacker = hit.m_attacker;
+        auto victim = hit.m_victim;
+
+        m_appliedHits.push(hit.m_hitPos);
+        applyHit({attacker, m_reg.get<BattleActor>(attacker), m_reg.get<StateMachine>(attacker), m_reg.get<ComponentTransform>(attacker)},
+            {victim, m_reg.get<BattleActor>(victim), m_reg.get<StateMachine>(victim), m_reg.get<ComponentTransform>(victim)}, *hit.m_hit);
+    }
 }
 
 void BattleSystem::debugDraw() const
@@ -1,6 +1,8 @@
 #pragma once
 #include "Core/Camera.h"
 #include "Core/FixedQueue.hpp"
+#include "HitDetection.h"
+#include "HitRegistry.h"
 #include <entt/entt.hpp>
 
 namespace battle_debug {
@@ -33,7 +35,10 @@ private:
     entt::registry &m_reg;
     Camera &m_cam;
 
-    std::set<uint32_t> m_presentHits;
+    HitDetector m_hitDetector;
+    // Tags of hits active during the last update, sorted by slot
+    std::vector<HitTag> m_presentHits;
+    std::vector<HitTag> m_newPresentHits;
     FixedQueue<Vector2<float>, battle_debug::lastHitsShown> m_appliedHits;
 
 };
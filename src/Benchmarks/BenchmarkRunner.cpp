@@ -0,0 +1,116 @@
+#include "BenchmarkRunner.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+    uint64_t now()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+            ).count());
+    }
+}
+
+void BenchmarkRunner::add(std::string name_, BenchmarkFunc func_, BenchmarkHooks hooks_)
+{
+    m_benchmarks.push_back({std::move(name_), std::move(func_), std::move(hooks_)});
+}
+
+void BenchmarkRunner::run(const std::string &filter_)
+{
+    for (const auto &benchmark : m_benchmarks)
+    {
+        if (!filter_.empty() && benchmark.m_name.find(filter_) == std::string::npos)
+            continue;
+
+        if (benchmark.m_hooks.m_setup)
+            benchmark.m_hooks.m_setup();
+
+        m_results.push_back(runSingle(benchmark));
+
+        if (benchmark.m_hooks.m_teardown)
+            benchmark.m_hooks.m_teardown();
+
+        const auto &res = m_results.back();
+        std::cerr << benchmark.m_name << ": " << res.m_medianNs << " ns/op (min " << res.m_minNs << ")" << std::endl;
+    }
+}
+
+BenchmarkResult BenchmarkRunner::runSingle(const Benchmark &benchmark_) const
+{
+    const auto &func = benchmark_.m_func;
+
+    BenchmarkResult res;
+    res.m_name = benchmark_.m_name;
+    res.m_itemsPerOp = std::max<size_t>(1, benchmark_.m_hooks.m_itemsPerOp);
+
+    // Grow iterations until a single run is long enough to be measured reliably, also warms up caches
+    size_t iterations = 1;
+    uint64_t passed = 0;
+    while (true)
+    {
+        const auto begin = now();
+        res.m_checksum += func(iterations);
+        passed = now() - begin;
+
+        if (passed >= SAMPLE_DURATION_NS / 10)
+            break;
+
+        iterations *= 2;
+    }
+
+    iterations = std::max<size_t>(1, static_cast<size_t>(static_cast<double>(iterations) * SAMPLE_DURATION_NS / static_cast<double>(passed)));
+    res.m_iterations = iterations;
+
+    std::vector<double> samples;
+    samples.reserve(SAMPLES);
+    for (size_t i = 0; i < SAMPLES; ++i)
+    {
+        const auto begin = now();
+        res.m_checksum += func(iterations);
+        samples.push_back(static_cast<double>(now() - begin) / static_cast<double>(iterations));
+    }
+
+    std::sort(samples.begin(), samples.end());
+    res.m_minNs = samples.front();
+    res.m_medianNs = samples[samples.size() / 2];
+
+    double sum = 0.0;
+    for (const auto &sample : samples)
+        sum += sample;
+    res.m_meanNs = sum / static_cast<double>(samples.size());
+
+    return res;
+}
+
+nlohmann::json BenchmarkRunner::toJson() const
+{
+    nlohmann::json benchmarks = nlohmann::json::array();
+    for (const auto &res : m_results)
+    {
+        benchmarks.push_back({
+            {"name", res.m_name},
+            {"iterations", res.m_iterations},
+            {"samples", SAMPLES},
+            {"ns_per_op_min", res.m_minNs},
+            {"ns_per_op_median", res.m_medianNs},
+            {"ns_per_op_mean", res.m_meanNs},
+            {"items_per_op", res.m_itemsPerOp},
+            {"ns_per_item_median", res.m_medianNs / static_cast<double>(res.m_itemsPerOp)},
+            {"checksum", res.m_checksum}
+        });
+    }
+
+#ifdef NDEBUG
+    constexpr bool isRelease = true;
+#else
+    constexpr bool isRelease = false;
+#endif
+
+    return {
+        {"release_build", isRelease},
+        {"benchmarks", benchmarks}
+    };
+}
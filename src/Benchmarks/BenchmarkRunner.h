@@ -0,0 +1,72 @@
+#pragma once
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+    Minimal microbenchmark harness
+    Benchmark function runs measured operation iterations_ times and returns a checksum of the results,
+        checksum ends up in the report, so compiler cannot throw the work away
+    Number of iterations is picked so each sample takes about SAMPLE_DURATION_NS
+*/
+using BenchmarkFunc = std::function<uint64_t(size_t iterations_)>;
+
+struct BenchmarkHooks
+{
+    // For operations over collections, report is also normalized per item
+    size_t m_itemsPerOp = 1;
+
+    // Called before and after measurements, so heavy data only lives while its benchmark runs
+    std::function<void()> m_setup;
+    std::function<void()> m_teardown;
+};
+
+struct BenchmarkResult
+{
+    std::string m_name;
+    size_t m_iterations = 0;
+    size_t m_itemsPerOp = 1;
+    double m_minNs = 0.0;
+    double m_medianNs = 0.0;
+    double m_meanNs = 0.0;
+    uint64_t m_checksum = 0;
+};
+
+class BenchmarkRunner
+{
+public:
+    static constexpr uint64_t SAMPLE_DURATION_NS = 20'000'000;
+    static constexpr size_t SAMPLES = 9;
+
+    void add(std::string name_, BenchmarkFunc func_, BenchmarkHooks hooks_ = {});
+
+    // Runs all benchmarks with filter_ as a substring of the name, empty filter runs everything
+    void run(const std::string &filter_);
+
+    nlohmann::json toJson() const;
+
+private:
+    struct Benchmark
+    {
+        std::string m_name;
+        BenchmarkFunc m_func;
+        BenchmarkHooks m_hooks;
+    };
+
+    BenchmarkResult runSingle(const Benchmark &benchmark_) const;
+
+    std::vector<Benchmark> m_benchmarks;
+    std::vector<BenchmarkResult> m_results;
+};
+
+// Smears bits of any value into a checksum
+template<typename T>
+uint64_t benchChecksum(const T &value_)
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return static_cast<uint64_t>(static_cast<int64_t>(static_cast<double>(value_) * 1000.0));
+    else
+        return static_cast<uint64_t>(value_);
+}
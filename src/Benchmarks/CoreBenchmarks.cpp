@@ -0,0 +1,295 @@
+#include "CoreBenchmarks.h"
+#include "Core/Collider.h"
+#include "Core/FixedQueue.hpp"
+#include "Core/InputSystem.h"
+#include "Core/SlidingWindow.hpp"
+#include "Core/TimelineProperty.hpp"
+#include "Core/Vector2.hpp"
+#include "Core/utf8.h"
+#include <format>
+#include <memory>
+#include <random>
+
+namespace
+{
+    // Power of two, so data index is a single AND
+    constexpr size_t DATA_SIZE = 4096;
+    constexpr size_t DATA_MASK = DATA_SIZE - 1;
+
+    template<typename T>
+    using SharedData = std::shared_ptr<const std::vector<T>>;
+
+    template<typename T, typename GenT>
+    SharedData<T> generate(size_t count_, GenT &&gen_)
+    {
+        auto res = std::make_shared<std::vector<T>>();
+        res->reserve(count_);
+        for (size_t i = 0; i < count_; ++i)
+            res->push_back(gen_(i));
+
+        return res;
+    }
+
+    void registerVector2(BenchmarkRunner &runner_, std::mt19937 &rng_)
+    {
+        std::uniform_real_distribution<float> coord(-500.0f, 500.0f);
+        const auto points = generate<Vector2<float>>(DATA_SIZE, [&](size_t) { return Vector2{coord(rng_), coord(rng_)}; });
+
+        runner_.add("vector2/add_scale", [points](size_t iterations_) {
+            const auto &pts = *points;
+            Vector2<float> acc;
+            for (size_t i = 0; i < iterations_; ++i)
+                acc += pts[i & DATA_MASK] + pts[(i + 1) & DATA_MASK] * 0.5f;
+
+            return benchChecksum(acc.x + acc.y);
+        });
+
+        runner_.add("vector2/length", [points](size_t iterations_) {
+            const auto &pts = *points;
+            float acc = 0.0f;
+            for (size_t i = 0; i < iterations_; ++i)
+                acc += pts[i & DATA_MASK].length();
+
+            return benchChecksum(acc);
+        });
+
+        runner_.add("vector2/normalised", [points](size_t iterations_) {
+            const auto &pts = *points;
+            Vector2<float> acc;
+            for (size_t i = 0; i < iterations_; ++i)
+                acc += pts[i & DATA_MASK].normalised();
+
+            return benchChecksum(acc.x + acc.y);
+        });
+
+        runner_.add("utils/distToLineSegment", [points](size_t iterations_) {
+            const auto &pts = *points;
+            float acc = 0.0f;
+            for (size_t i = 0; i < iterations_; ++i)
+                acc += utils::distToLineSegment(pts[i & DATA_MASK], pts[(i + 1) & DATA_MASK], pts[(i + 2) & DATA_MASK]);
+
+            return benchChecksum(acc);
+        });
+    }
+
+    void registerColliders(BenchmarkRunner &runner_, std::mt19937 &rng_)
+    {
+        std::uniform_int_distribution<int> pos(0, 512);
+        std::uniform_int_distribution<int> size(8, 128);
+
+        const auto colliders = generate<Collider>(DATA_SIZE, [&](size_t) {
+            return Collider{Vector2{pos(rng_), pos(rng_)}, Vector2{size(rng_), size(rng_)}};
+        });
+
+        // Mix of rising, falling and flat slopes over the same area as colliders
+        const auto slopes = generate<SlopeCollider>(64, [&](size_t i_) {
+            const auto left = Vector2{pos(rng_), pos(rng_)};
+            const auto width = size(rng_) * 2;
+            const auto rise = (i_ % 3 == 0 ? 0 : size(rng_) * (i_ % 3 == 1 ? 1 : -1));
+            const auto right = left + Vector2{width, rise};
+            return SlopeCollider(left, right, std::max(left.y, right.y) + size(rng_));
+        });
+
+        runner_.add("collider/getOverlapArea", [colliders](size_t iterations_) {
+            const auto &clds = *colliders;
+            int64_t acc = 0;
+            for (size_t i = 0; i < iterations_; ++i)
+            {
+                const auto area = clds[i & DATA_MASK].getOverlapArea(clds[(i + 1) & DATA_MASK]);
+                acc += area.m_size.x + area.m_topLeft.y;
+            }
+
+            return benchChecksum(acc);
+        });
+
+        runner_.add("slope/checkOverlap", [colliders, slopes](size_t iterations_) {
+            const auto &clds = *colliders;
+            const auto &slps = *slopes;
+            uint64_t acc = 0;
+            int highest = 0;
+            for (size_t i = 0; i < iterations_; ++i)
+            {
+                acc += static_cast<uint64_t>(static_cast<OverlapResult>(slps[i % slps.size()].checkOverlap(clds[i & DATA_MASK], highest)));
+                acc += static_cast<uint64_t>(highest);
+            }
+
+            return acc;
+        });
+
+        runner_.add("slope/getHeightAt", [slopes](size_t iterations_) {
+            const auto &slps = *slopes;
+            int64_t acc = 0;
+            for (size_t i = 0; i < iterations_; ++i)
+            {
+                const auto &slope = slps[i % slps.size()];
+                acc += slope.getHeightAt(slope.leftX() + static_cast<int>(i % static_cast<size_t>(slope.rightX() - slope.leftX() + 1)));
+            }
+
+            return benchChecksum(acc);
+        });
+    }
+
+    /*
+        Short timeline is baked into a dense table, long one goes over the bake threshold and uses search
+        Sequential access walks over frames like an animation does, random access jumps anywhere
+    */
+    void registerTimeline(BenchmarkRunner &runner_, std::mt19937 &rng_)
+    {
+        const auto makeTimeline = [](uint32_t duration_, uint32_t step_) {
+            auto timeline = std::make_shared<TimelineProperty<int>>();
+            for (uint32_t frame = 0; frame < duration_; frame += step_)
+                timeline->addPair(frame, static_cast<int>(frame * 7 + 1));
+
+            return std::shared_ptr<const TimelineProperty<int>>(std::move(timeline));
+        };
+
+        const std::pair<const char*, std::shared_ptr<const TimelineProperty<int>>> timelines[] = {
+            {"baked", makeTimeline(200, 3)},
+            {"search", makeTimeline(2000, 7)}
+        };
+
+        for (const auto &[kind, timeline] : timelines)
+        {
+            const uint32_t duration = (timeline->isBaked() ? 200 : 2000);
+            std::uniform_int_distribution<uint32_t> frame(0, duration - 1);
+            const auto frames = generate<uint32_t>(DATA_SIZE, [&](size_t) { return frame(rng_); });
+
+            runner_.add(std::format("timeline/{}/sequential_cursor", kind), [timeline, duration](size_t iterations_) {
+                TimelineProperty<int>::Cursor cursor;
+                int64_t acc = 0;
+                for (size_t i = 0; i < iterations_; ++i)
+                    acc += timeline->get(static_cast<uint32_t>(i % duration), cursor);
+
+                return benchChecksum(acc);
+            });
+
+            runner_.add(std::format("timeline/{}/sequential_index", kind), [timeline, duration](size_t iterations_) {
+                int64_t acc = 0;
+                for (size_t i = 0; i < iterations_; ++i)
+                    acc += (*timeline)[static_cast<uint32_t>(i % duration)];
+
+                return benchChecksum(acc);
+            });
+
+            runner_.add(std::format("timeline/{}/random_index", kind), [timeline, frames](size_t iterations_) {
+                const auto &frms = *frames;
+                int64_t acc = 0;
+                for (size_t i = 0; i < iterations_; ++i)
+                    acc += (*timeline)[frms[i & DATA_MASK]];
+
+                return benchChecksum(acc);
+            });
+        }
+    }
+
+    void registerContainers(BenchmarkRunner &runner_)
+    {
+        runner_.add("fixedqueue/push_access", [](size_t iterations_) {
+            FixedQueue<int, 30> queue;
+            int64_t acc = 0;
+            for (size_t i = 0; i < iterations_; ++i)
+            {
+                queue.push(static_cast<int>(i));
+                acc += queue[i % queue.getFilled()];
+            }
+
+            return benchChecksum(acc);
+        });
+
+        runner_.add("slidingwindow/push_avg", [](size_t iterations_) {
+            SlidingWindow<float, 30> window;
+            float acc = 0.0f;
+            for (size_t i = 0; i < iterations_; ++i)
+            {
+                window.push(static_cast<float>(i & 255));
+                acc += window.avg();
+            }
+
+            return benchChecksum(acc);
+        });
+    }
+
+    void registerStaticMapping(BenchmarkRunner &runner_)
+    {
+        auto keys = std::make_shared<std::vector<SDL_Keycode>>();
+        auto names = std::make_shared<std::vector<std::string>>();
+        for (const auto &[key, name] : makeDirectMap<SDL_Keycode>())
+        {
+            keys->push_back(key);
+            names->push_back(name);
+        }
+
+        runner_.add("staticmapping/serialize", [keys](size_t iterations_) {
+            const auto &ks = *keys;
+            uint64_t acc = 0;
+            for (size_t i = 0; i < iterations_; ++i)
+                acc += serialize(ks[i % ks.size()]).size();
+
+            return acc;
+        });
+
+        runner_.add("staticmapping/deserialize", [names](size_t iterations_) {
+            const auto &ns = *names;
+            uint64_t acc = 0;
+            for (size_t i = 0; i < iterations_; ++i)
+                acc += static_cast<uint64_t>(deserialize<SDL_Keycode>(ns[i % ns.size()]));
+
+            return acc;
+        });
+    }
+
+    // One operation is one decoded character
+    void registerUtf8(BenchmarkRunner &runner_)
+    {
+        auto text = std::make_shared<std::string>();
+        while (text->size() < DATA_SIZE)
+            *text += "Hello, мир! Ça va? こんにちは 🙂 ";
+
+        runner_.add("utf8/decode_raw", [text](size_t iterations_) {
+            const char *begin = text->data();
+            const char *end = begin + text->size();
+            const char *ch = begin;
+            uint64_t acc = 0;
+            for (size_t i = 0; i < iterations_; ++i)
+            {
+                if (ch >= end)
+                    ch = begin;
+
+                const auto sz = utf8::readCharSize(ch);
+                acc += utf8::tou32(ch, sz);
+                ch += sz;
+            }
+
+            return acc;
+        });
+
+        runner_.add("utf8/decode_wrapper", [text](size_t iterations_) {
+            const U8Wrapper wrapper(*text);
+            uint64_t acc = 0;
+            size_t decoded = 0;
+            while (decoded < iterations_)
+            {
+                for (auto &ch : wrapper)
+                {
+                    acc += ch.getu32();
+                    if (++decoded == iterations_)
+                        break;
+                }
+            }
+
+            return acc;
+        });
+    }
+}
+
+void registerCoreBenchmarks(BenchmarkRunner &runner_)
+{
+    std::mt19937 rng(12345);
+
+    registerVector2(runner_, rng);
+    registerColliders(runner_, rng);
+    registerTimeline(runner_, rng);
+    registerContainers(runner_);
+    registerStaticMapping(runner_);
+    registerUtf8(runner_);
+}
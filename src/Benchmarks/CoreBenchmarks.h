@@ -0,0 +1,5 @@
+#pragma once
+#include "BenchmarkRunner.h"
+
+// Vector2, colliders, timelines, containers, static mapping and UTF-8 decoding
+void registerCoreBenchmarks(BenchmarkRunner &runner_);
@@ -0,0 +1,318 @@
+#include "EcsBenchmarks.h"
+#include "Core/CoreComponents.h"
+#include "Core/RenderQueue.h"
+#include <entt/entt.hpp>
+#include <algorithm>
+#include <format>
+#include <memory>
+#include <random>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    template<uint64_t I>
+    struct Comp
+    {
+        uint64_t add(uint64_t arg_) const
+        {
+            return I + arg_ + m_value;
+        }
+
+        uint64_t m_value = I;
+    };
+
+    struct Marker
+    {};
+
+    // Cheap, but different for different entities
+    uint64_t entityArg(entt::entity ent_)
+    {
+        return static_cast<uint64_t>(entt::to_integral(ent_)) & 3;
+    }
+
+    /*
+        Component access through a type-erased interface, the way a runtime-configured system would do it
+        Extractors are looked up by type hash, type name or type_info pointer
+    */
+    class IExtractor
+    {
+    public:
+        IExtractor(const entt::registry &reg_) :
+            m_reg{reg_}
+        {}
+
+        virtual uint64_t handle(entt::entity ent_) const = 0;
+
+        virtual ~IExtractor() = default;
+
+    protected:
+        const entt::registry &m_reg;
+    };
+
+    template<typename T>
+    class Extractor : public IExtractor
+    {
+    public:
+        Extractor(const entt::registry &reg_) :
+            IExtractor(reg_)
+        {}
+
+        uint64_t handle(entt::entity ent_) const override
+        {
+            return m_reg.get<T>(ent_).add(entityArg(ent_));
+        }
+    };
+
+    template<typename KeyT>
+    using ExtractorMap = std::unordered_map<KeyT, std::unique_ptr<IExtractor>>;
+
+    enum class Sparsity : uint8_t
+    {
+        DENSE,      // All entities have marker and components, created in the same order
+        SPARSE,     // All entities have components, every 10th has marker
+        SCATTERED   // All entities have marker and components, but components were added in random order
+    };
+
+    const char *sparsityName(Sparsity sparsity_)
+    {
+        switch (sparsity_)
+        {
+            case (Sparsity::DENSE):
+                return "dense";
+            case (Sparsity::SPARSE):
+                return "sparse";
+            default:
+                return "scattered";
+        }
+    }
+
+    size_t markedCount(size_t entities_, Sparsity sparsity_)
+    {
+        return (sparsity_ == Sparsity::SPARSE ? (entities_ + 9) / 10 : entities_);
+    }
+
+    template<size_t... Is>
+    struct Fixture
+    {
+        entt::registry m_reg;
+
+        ExtractorMap<entt::id_type> m_byHash;
+        ExtractorMap<std::string> m_byName;
+        ExtractorMap<const std::type_info*> m_byTypeInfo;
+
+        std::vector<entt::id_type> m_hashes = {entt::type_hash<Comp<Is>>::value()...};
+        std::vector<std::string> m_names = {typeid(Comp<Is>).name()...};
+        std::vector<const std::type_info*> m_typeInfos = {&typeid(Comp<Is>)...};
+
+        Fixture(size_t entities_, Sparsity sparsity_)
+        {
+            std::vector<entt::entity> ents(entities_);
+            m_reg.create(ents.begin(), ents.end());
+
+            auto componentOrder = ents;
+            if (sparsity_ == Sparsity::SCATTERED)
+                std::shuffle(componentOrder.begin(), componentOrder.end(), std::mt19937(12345));
+
+            for (const auto &ent : componentOrder)
+                (m_reg.emplace<Comp<Is>>(ent), ...);
+
+            for (size_t i = 0; i < ents.size(); ++i)
+            {
+                if (sparsity_ != Sparsity::SPARSE || i % 10 == 0)
+                    m_reg.emplace<Marker>(ents[i]);
+            }
+
+            (m_byHash.emplace(entt::type_hash<Comp<Is>>::value(), std::make_unique<Extractor<Comp<Is>>>(m_reg)), ...);
+            (m_byName.emplace(typeid(Comp<Is>).name(), std::make_unique<Extractor<Comp<Is>>>(m_reg)), ...);
+            (m_byTypeInfo.emplace(&typeid(Comp<Is>), std::make_unique<Extractor<Comp<Is>>>(m_reg)), ...);
+        }
+    };
+
+    // Multi-component view, components come from each() - the way ComponentsView works
+    template<size_t... Is>
+    uint64_t viewEach(Fixture<Is...> &fixture_)
+    {
+        uint64_t res = 0;
+        const auto &reg = fixture_.m_reg;
+        reg.view<Marker, Comp<Is>...>().each([&](entt::entity ent_, const Comp<Is>&... comps_) {
+            res += (comps_.add(entityArg(ent_)) + ...);
+        });
+
+        return res;
+    }
+
+    // View over marker only, each component fetched with get
+    template<size_t... Is>
+    uint64_t viewGet(Fixture<Is...> &fixture_)
+    {
+        uint64_t res = 0;
+        const auto &reg = fixture_.m_reg;
+        for (const auto ent : reg.view<Marker>())
+            res += (reg.get<Comp<Is>>(ent).add(entityArg(ent)) + ...);
+
+        return res;
+    }
+
+    template<typename KeyT, size_t... Is>
+    uint64_t viewExtractors(Fixture<Is...> &fixture_, const ExtractorMap<KeyT> &extractors_, const std::vector<KeyT> &keys_)
+    {
+        uint64_t res = 0;
+        for (const auto ent : fixture_.m_reg.template view<Marker>())
+        {
+            for (const auto &key : keys_)
+                res += extractors_.at(key)->handle(ent);
+        }
+
+        return res;
+    }
+
+    // Storages are picked by hash at runtime, components are accessed through extractors
+    template<size_t... Is>
+    uint64_t runtimeView(Fixture<Is...> &fixture_)
+    {
+        auto &reg = fixture_.m_reg;
+        entt::runtime_view view;
+        view.iterate(*reg.storage(entt::type_hash<Marker>::value()));
+        for (const auto &hash : fixture_.m_hashes)
+            view.iterate(*reg.storage(hash));
+
+        uint64_t res = 0;
+        for (const auto ent : view)
+        {
+            for (const auto &hash : fixture_.m_hashes)
+                res += fixture_.m_byHash.at(hash)->handle(ent);
+        }
+
+        return res;
+    }
+
+    // Group owns all storages, so matching entities are packed at the front of each of them
+    template<size_t... Is>
+    uint64_t owningGroup(Fixture<Is...> &fixture_)
+    {
+        uint64_t res = 0;
+        fixture_.m_reg.template group<Marker, Comp<Is>...>().each([&](entt::entity ent_, const Comp<Is>&... comps_) {
+            res += (comps_.add(entityArg(ent_)) + ...);
+        });
+
+        return res;
+    }
+
+    template<size_t... Is>
+    void registerCase(BenchmarkRunner &runner_, size_t entities_, Sparsity sparsity_, std::index_sequence<Is...>)
+    {
+        using FixtureT = Fixture<Is...>;
+        using AccessFunc = uint64_t(*)(FixtureT&);
+
+        const std::pair<const char*, AccessFunc> strategies[] = {
+            {"view_each", &viewEach<Is...>},
+            {"view_get", &viewGet<Is...>},
+            {"extractor_hash", [](FixtureT &fixture_) { return viewExtractors(fixture_, fixture_.m_byHash, fixture_.m_hashes); }},
+            {"extractor_name", [](FixtureT &fixture_) { return viewExtractors(fixture_, fixture_.m_byName, fixture_.m_names); }},
+            {"extractor_typeinfo", [](FixtureT &fixture_) { return viewExtractors(fixture_, fixture_.m_byTypeInfo, fixture_.m_typeInfos); }},
+            {"runtime_view", &runtimeView<Is...>},
+            {"owning_group", &owningGroup<Is...>}
+        };
+
+        for (const auto &[strategy, access] : strategies)
+        {
+            // Registry is only built while its benchmark runs, large ones take a lot of memory
+            auto fixture = std::make_shared<std::unique_ptr<FixtureT>>();
+
+            BenchmarkHooks hooks;
+            hooks.m_itemsPerOp = markedCount(entities_, sparsity_);
+            hooks.m_setup = [fixture, entities_, sparsity_]() { *fixture = std::make_unique<FixtureT>(entities_, sparsity_); };
+            hooks.m_teardown = [fixture]() { fixture->reset(); };
+
+            runner_.add(std::format("ecs/{}/{}/{}c/{}", strategy, sparsityName(sparsity_), sizeof...(Is), entities_),
+                [fixture, access](size_t iterations_) {
+                    uint64_t res = 0;
+                    for (size_t i = 0; i < iterations_; ++i)
+                        res += access(**fixture);
+
+                    return res;
+                },
+                std::move(hooks));
+        }
+    }
+
+    constexpr int RENDER_DEPTHS = 8;
+
+    struct RenderOrderFixture
+    {
+        entt::registry m_reg;
+        std::unique_ptr<RenderQueue> m_queue;
+
+        RenderOrderFixture(size_t entities_, bool withQueue_)
+        {
+            if (withQueue_)
+                m_queue = std::make_unique<RenderQueue>(m_reg);
+
+            for (size_t i = 0; i < entities_; ++i)
+                m_reg.emplace<RenderLayer>(m_reg.create(), static_cast<int>(i % RENDER_DEPTHS));
+        }
+    };
+
+    /*
+        Single entity gets a RenderLayer and loses it again, then draw order is brought up to date
+        Registry sort is what had to happen every frame something was spawned, the queue does all the work in signals
+    */
+    void registerRenderOrder(BenchmarkRunner &runner_, size_t entities_, bool withQueue_)
+    {
+        auto fixture = std::make_shared<std::unique_ptr<RenderOrderFixture>>();
+
+        BenchmarkHooks hooks;
+        hooks.m_setup = [fixture, entities_, withQueue_]() { *fixture = std::make_unique<RenderOrderFixture>(entities_, withQueue_); };
+        hooks.m_teardown = [fixture]() { fixture->reset(); };
+
+        runner_.add(std::format("render_order/{}/{}", (withQueue_ ? "queue" : "registry_sort"), entities_),
+            [fixture, withQueue_](size_t iterations_) {
+                auto &reg = (*fixture)->m_reg;
+                uint64_t res = 0;
+                for (size_t i = 0; i < iterations_; ++i)
+                {
+                    const auto ent = reg.create();
+                    reg.emplace<RenderLayer>(ent, static_cast<int>(i % RENDER_DEPTHS));
+                    reg.destroy(ent);
+
+                    if (withQueue_)
+                    {
+                        res += (*fixture)->m_queue->size();
+                    }
+                    else
+                    {
+                        reg.sort<RenderLayer>([](const RenderLayer &lhs_, const RenderLayer &rhs_) {
+                            return lhs_.getDepth() > rhs_.getDepth();
+                        });
+                        res += reg.storage<RenderLayer>().size();
+                    }
+                }
+
+                return res;
+            },
+            std::move(hooks));
+    }
+}
+
+void registerEcsBenchmarks(BenchmarkRunner &runner_)
+{
+    for (const auto sparsity : {Sparsity::DENSE, Sparsity::SPARSE, Sparsity::SCATTERED})
+    {
+        for (const size_t entities : {1'000, 10'000, 100'000})
+        {
+            registerCase(runner_, entities, sparsity, std::make_index_sequence<1>{});
+            registerCase(runner_, entities, sparsity, std::make_index_sequence<4>{});
+            registerCase(runner_, entities, sparsity, std::make_index_sequence<8>{});
+        }
+    }
+
+    for (const size_t entities : {1'000, 10'000, 100'000})
+    {
+        registerRenderOrder(runner_, entities, false);
+        registerRenderOrder(runner_, entities, true);
+    }
+}
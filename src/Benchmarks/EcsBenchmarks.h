@@ -0,0 +1,9 @@
+#pragma once
+#include "BenchmarkRunner.h"
+
+/*
+    Ways of reaching components of entities selected by a marker component
+    Parameterised over registry size, number of accessed components and how entities with the marker are distributed
+    Also cost of keeping the draw order of RenderLayer entities up to date when one of them is spawned
+*/
+void registerEcsBenchmarks(BenchmarkRunner &runner_);
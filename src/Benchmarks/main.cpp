@@ -0,0 +1,63 @@
+#include "BenchmarkRunner.h"
+#include "CoreBenchmarks.h"
+#include "EcsBenchmarks.h"
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+/*
+    CoreBenchmarks [--filter <substring>] [--out <file.json>]
+    Progress goes to stderr, JSON report goes to stdout or to the file
+*/
+int main(int argc_, char** argv_)
+{
+    std::string filter;
+    std::string outPath;
+
+    for (int i = 1; i < argc_; ++i)
+    {
+        const std::string_view arg = argv_[i];
+        if (arg == "--filter" && i + 1 < argc_)
+            filter = argv_[++i];
+        else if (arg == "--out" && i + 1 < argc_)
+            outPath = argv_[++i];
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            std::cerr << "Usage: " << argv_[0] << " [--filter <substring>] [--out <file.json>]" << std::endl;
+            return 1;
+        }
+    }
+
+    try
+    {
+        BenchmarkRunner runner;
+        registerCoreBenchmarks(runner);
+        registerEcsBenchmarks(runner);
+        runner.run(filter);
+
+        const auto report = runner.toJson().dump(4);
+        if (outPath.empty())
+        {
+            std::cout << report << std::endl;
+        }
+        else
+        {
+            std::ofstream out(outPath);
+            if (!out.is_open())
+            {
+                std::cerr << "Failed to open " << outPath << std::endl;
+                return 1;
+            }
+
+            out << report << std::endl;
+        }
+    }
+    catch (std::exception &ex_)
+    {
+        std::cerr << "Exception while running benchmarks: " << ex_.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -3,7 +3,7 @@
 #include "Core/GameData.h"
 #include "Core/InputResolver.h"
 #include "Core/Vector2.hpp"
-#include "Core/utf8.h"
+#include <bit>
 #include <memory>
 #include <stdexcept>
 #include "ChatBox.h"
@@ -22,79 +22,8 @@ namespace ChatConsts
     const uint32_t fadeOutDuration = 7;
 }
 
-template <>
-std::string InlinedValueHandler::getParam<std::string>(size_t index_)
-{
-    return m_tokens[index_];
-}
-
-template <>
-std::string InlinedValueHandler::getParam<std::string>(size_t index_, const std::string &default_)
-{
-    if (index_ >= m_tokens.size() || m_tokens[index_] == "default")
-        return default_;
-
-    return m_tokens[index_];
-}
-
-template <>
-int InlinedValueHandler::getParam<int>(size_t index_)
-{
-    return std::stoi(m_tokens[index_]);
-}
-
-template <>
-int InlinedValueHandler::getParam<int>(size_t index_, const int &default_)
-{
-    if (index_ >= m_tokens.size() || m_tokens[index_] == "default")
-        return default_;
-
-    return std::stoi(m_tokens[index_]);
-}
-
-template <>
-uint8_t InlinedValueHandler::getParam<uint8_t>(size_t index_)
-{
-    return std::stoi(m_tokens[index_]);
-}
-
-template <>
-uint8_t InlinedValueHandler::getParam<uint8_t>(size_t index_, const uint8_t &default_)
-{
-    if (index_ >= m_tokens.size() || m_tokens[index_] == "default")
-        return default_;
-
-    return std::stoi(m_tokens[index_]);
-}
-
-template <>
-uint32_t InlinedValueHandler::getParam<uint32_t>(size_t index_)
-{
-    return std::stoi(m_tokens[index_]);
-}
-
-template <>
-uint32_t InlinedValueHandler::getParam<uint32_t>(size_t index_, const uint32_t &default_)
-{
-    if (index_ >= m_tokens.size() || m_tokens[index_] == "default")
-        return default_;
-
-    return std::stoi(m_tokens[index_]);
-}
-
-template <>
-float InlinedValueHandler::getParam<float>(size_t index_, const float &default_)
-{
-    if (index_ >= m_tokens.size() || m_tokens[index_] == "default")
-        return default_;
-
-    return std::stof(m_tokens[index_]);
-}
-
-
 ChatSymbol::RenderData::RenderData(const fonts::Symbol &symbol_) :
-    id{symbol_.m_id},
-    size{symbol_.m_size},
+    symbol{&symbol_},
     advance{symbol_.m_advance}
 {}
 
@@ -111,6 +40,11 @@ Line::Line(int minx_, int height_) :
     m_width{minx_}
 {}
 
+void Line::reserve(size_t count_)
+{
+    m_symbols.reserve(count_);
+}
+
 void Line::addSymbol(ChatSymbol &&sym_)
 {
     m_symbols.emplace_back(std::move(sym_));
@@ -148,83 +82,44 @@ const std::vector<ChatSymbol> &Line::symbols() const noexcept
     return m_symbols;
 }
 
-ChatMessage::ChatMessage(const std::string &str_)
+ChatMessage::ChatMessage(const ChatScript &script_)
 {
-    auto &textMan = Application::instance().m_textManager;
-
-    auto &font = textMan.getFont(Fonts::CHATBOX);
-
+    CharAppearanceSpeed speed;
+    ChatSymbol::Effects::Shake shake;
     uint32_t extraDelay = 0;
 
-    // Effect stacks
-    std::stack<ChatSymbol::Effects::Shake> shakeStack;
-    shakeStack.emplace();
-
-    std::stack<CharAppearanceSpeed> speedStack;
-    speedStack.emplace();
-
-    // Parsing
-    U8Wrapper wrp(str_);
+    m_lines.reserve(script_.getLineCount());
 
-    bool newLine = true;
-
-    bool readingCmd = false;
-    std::string cmd;
-
-    for (auto &ch : wrp)
+    const auto &code = script_.getCode();
+    for (size_t i = 0; i < code.size(); ++i)
     {
-        if (readingCmd)
+        const auto operand = ChatScript::getOperand(code[i]);
+        switch (ChatScript::getOp(code[i]))
         {
-            if (ch.m_byteSize > 1)
-                throw std::runtime_error("Impossible char size in dialogue command");
-
-            if (*ch.m_ch == '>')
-            {
-                readingCmd = false;
-                InlinedValueHandler parser(cmd);
-                if (parser.getCommand() == "charspd")
-                    speedStack.emplace(parser.getParam<uint32_t>(0, CharAppearanceSpeed::defaultDelay), parser.getParam<uint32_t>(1, CharAppearanceSpeed::defaultDuration));
-                else if (parser.getCommand() == "/charspd")
-                    speedStack.pop();
-                else if (parser.getCommand() == "shake")
-                    shakeStack.emplace(
-                        parser.getParam<uint8_t>(0, ChatSymbol::Effects::Shake::defaultXAmp), 
-                        parser.getParam<uint8_t>(1, ChatSymbol::Effects::Shake::defaultYAmp),
-                        parser.getParam<float>(2, ChatSymbol::Effects::Shake::defaultProb));
-                else if (parser.getCommand() == "/shake")
-                    shakeStack.pop();
-                else if (parser.getCommand() == "delay")
-                    extraDelay = parser.getParam<uint8_t>(0);
-                else
-                    throw std::runtime_error(std::format("Unknown command \"{}\"", cmd));
-            }
-            else if (*ch.m_ch != ' ' && *ch.m_ch != '\t')
-                cmd += *ch.m_ch;
-        }
-        else
-        {
-            if (ch.m_byteSize == 1 && *ch.m_ch == '<')
-            {
-                readingCmd = true;
-                cmd = "";
-                continue;
-            }
-
-            const auto &sym = font[ch.getu8()];
-
-            if (newLine)
-            {
-                m_lines.emplace_back(sym.m_minx, font.height());
-                newLine = false;
-            }
+            case ChatOp::LINE:
+                m_lines.emplace_back(std::bit_cast<int>(code[++i]), script_.getLineHeight());
+                m_lines.back().reserve(operand);
+                break;
 
-            if (*ch.m_ch == '\n')
-                newLine = true;
-            else
-            {
-                m_lines.back().addSymbol(ChatSymbol{sym, speedStack.top(), extraDelay, ChatSymbol::Effects{shakeStack.top()}});
+            case ChatOp::GLYPH:
+                m_lines.back().addSymbol(ChatSymbol{script_.getGlyph(operand), speed, extraDelay, ChatSymbol::Effects{shake}});
                 extraDelay = 0;
-            }
+                break;
+
+            case ChatOp::SPEED:
+                speed.delay = code[++i];
+                speed.duration = code[++i];
+                break;
+
+            case ChatOp::SHAKE:
+                shake.xAmp = static_cast<uint8_t>(operand & 0xFF);
+                shake.yAmp = static_cast<uint8_t>(operand >> 8);
+                shake.prob = std::bit_cast<float>(code[++i]);
+                break;
+
+            case ChatOp::DELAY:
+                extraDelay = operand;
+                break;
         }
     }
 
@@ -302,7 +197,7 @@ ChatMessageSequence::ChatMessageSequence(entt::entity source_, ChatBoxSide side_
 
 void ChatMessageSequence::addMessage(const std::string &message_)
 {
-    m_messages.emplace_back(message_);
+    m_messages.emplace_back(ChatScriptLibrary::instance().get(message_));
     if (m_messages.size() == 1)
         newSize = m_messages.front().size();
 }
@@ -410,6 +305,7 @@ bool ChatMessageSequence::fitScreen() const noexcept
 
 SequenceRenderer::SequenceRenderer(const ChatMessageSequence &seq_, const entt::registry &reg_, const Camera &cam_, const Texture &chatboxEdge_, const Texture &chatboxPointer_) :
     m_renderer{Application::instance().m_renderer},
+    m_textManager{Application::instance().m_textManager},
     m_seq{seq_},
     m_reg{reg_},
     m_cam{cam_},
@@ -530,7 +426,11 @@ void SequenceRenderer::drawImpl() const
 
     // Render message
     if (m_seq.hasMessagesLeft())
+    {
+        m_textManager.beginBatch();
         drawMessageImpl(m_seq.message());
+        m_textManager.endBatch();
+    }
 
 #if 0 // debugging
     m_renderer.drawRectangle(m_outerBoundTL, m_outerBoundBR - m_outerBoundTL, {255, 0, 0, 150});
@@ -568,7 +468,7 @@ void SequenceRenderer::drawMessageImpl(const ChatMessage &msg_) const
             }
 
             const auto progress = Easing::circ(sym.appearanceDuration.getProgressNormalized());
-            m_renderer.renderTexture(sym.renderData.id, Vector2{pos.x, pos.y - 5 + int(5 * progress)} + offset, sym.renderData.size, SDL_FLIP_NONE, progress);
+            m_textManager.renderSymbol(*sym.renderData.symbol, Vector2{pos.x, pos.y - 5 + int(5 * progress)} + offset, progress);
             pos.x += sym.renderData.advance;
         }
 
@@ -586,6 +486,9 @@ ChatboxSystem::ChatboxSystem(entt::registry &reg_, Camera &camera_) :
     subscribe(HUD_EVENTS::PROCEED);
     setInputEnabled();
 
+    // Dialogues are compiled on level load, so opening one only reads its script
+    ChatScriptLibrary::instance().preloadLocalization();
+
     auto &texman = Application::instance().m_textureManager;
 
     m_chatboxEdge = texman.getTexture(texman.getTexID("UI/chatbox_edge"));
@@ -643,20 +546,3 @@ void ChatboxSystem::draw() const
         SequenceRenderer{seq, m_reg, m_camera, *m_chatboxEdge, *m_chatboxPointer}.draw();
     }
 }
-
-InlinedValueHandler::InlinedValueHandler(const std::string &s_)
-{
-    const auto pos = s_.find_first_of('=');
-    if (pos == std::string::npos)
-        m_command = s_;
-    else
-    {
-        m_command = s_.substr(0, pos);
-        m_tokens = utils::tokenize(s_.substr(pos + 1), ',');
-    }
-}
-
-const std::string &InlinedValueHandler::getCommand() const noexcept
-{
-    return m_command;
-}
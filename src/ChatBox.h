@@ -3,8 +3,8 @@
 #include "InputHandlingSystem.h"
 #include "Core/Texture.h"
 #include "Core/TextManager.h"
+#include "ChatScript.h"
 #include <entt/entt.hpp>
-#include <stack>
 
 // TODO: store last used direction in sequence, don't change it if not necessary
 enum class ChatBoxSide : uint8_t
@@ -16,29 +16,6 @@ enum class ChatBoxSide : uint8_t
     AUTO // Wherever there is more free space
 };
 
-/**
-    Utility to parse sequences of comma-separated tokens
-    Takes line like "8,default,3", lets you extract individual elements by indices.
-    "default" is a key word that forces it to pick default value.
-*/
-class InlinedValueHandler
-{
-public:
-    InlinedValueHandler(const std::string &s_);
-
-    template<typename T>
-    T getParam(size_t index_);
-
-    template<typename T>
-    T getParam(size_t index_, const T &default_);
-
-    const std::string &getCommand() const noexcept;
-
-private:
-    std::string m_command;
-    std::vector<std::string> m_tokens;
-};
-
 struct CharAppearanceSpeed
 {
     static const uint32_t defaultDelay;
@@ -54,8 +31,8 @@ struct ChatSymbol
     {
         RenderData(const fonts::Symbol &symbol_);
 
-        unsigned int id = 0;
-        Vector2<int> size;
+        // Owned by the font
+        const fonts::Symbol *symbol = nullptr;
         int advance = 0;
     } renderData;
 
@@ -88,6 +65,7 @@ struct Line
 {
     Line(int minx_, int height_);
 
+    void reserve(size_t count_);
     void addSymbol(ChatSymbol &&sym_);
     int height() const noexcept;
     int width() const noexcept;
@@ -106,12 +84,12 @@ private:
 };
 
 /**
- *  Description of a text in a single text box, parsed in a constructor
+ *  Description of a text in a single text box, built from a compiled script
  */
 class ChatMessage
 {
 public:
-    ChatMessage(const std::string &str_);
+    ChatMessage(const ChatScript &script_);
 
     bool update();
     void skip();
@@ -186,6 +164,7 @@ private:
     void drawMessageImpl(const ChatMessage &msg) const;
 
     Renderer &m_renderer;
+    TextManager &m_textManager;
     const ChatMessageSequence &m_seq;
     const entt::registry &m_reg;
     const Camera &m_cam;
@@ -0,0 +1,349 @@
+#include "ChatScript.h"
+#include "ChatBox.h"
+#include "Core/Application.h"
+#include "Core/Localization/LocalizationGen.h"
+#include "Core/Logger.hpp"  // IWYU pragma: keep
+#include "Core/Utils.hpp"
+#include "Core/utf8.h"
+#include <bit>
+#include <format>
+#include <stdexcept>
+
+InlinedValueHandler::InlinedValueHandler(const std::string &s_)
+{
+    const auto pos = s_.find_first_of('=');
+    if (pos == std::string::npos)
+        m_command = s_;
+    else
+    {
+        m_command = s_.substr(0, pos);
+        m_tokens = utils::tokenize(s_.substr(pos + 1), ',');
+    }
+}
+
+const std::string &InlinedValueHandler::getCommand() const noexcept
+{
+    return m_command;
+}
+
+template <>
+std::string InlinedValueHandler::getParam<std::string>(size_t index_)
+{
+    return m_tokens[index_];
+}
+
+template <>
+std::string InlinedValueHandler::getParam<std::string>(size_t index_, const std::string &default_)
+{
+    if (index_ >= m_tokens.size() || m_tokens[index_] == "default")
+        return default_;
+
+    return m_tokens[index_];
+}
+
+template <>
+int InlinedValueHandler::getParam<int>(size_t index_)
+{
+    return std::stoi(m_tokens[index_]);
+}
+
+template <>
+int InlinedValueHandler::getParam<int>(size_t index_, const int &default_)
+{
+    if (index_ >= m_tokens.size() || m_tokens[index_] == "default")
+        return default_;
+
+    return std::stoi(m_tokens[index_]);
+}
+
+template <>
+uint8_t InlinedValueHandler::getParam<uint8_t>(size_t index_)
+{
+    return std::stoi(m_tokens[index_]);
+}
+
+template <>
+uint8_t InlinedValueHandler::getParam<uint8_t>(size_t index_, const uint8_t &default_)
+{
+    if (index_ >= m_tokens.size() || m_tokens[index_] == "default")
+        return default_;
+
+    return std::stoi(m_tokens[index_]);
+}
+
+template <>
+uint32_t InlinedValueHandler::getParam<uint32_t>(size_t index_)
+{
+    return std::stoi(m_tokens[index_]);
+}
+
+template <>
+uint32_t InlinedValueHandler::getParam<uint32_t>(size_t index_, const uint32_t &default_)
+{
+    if (index_ >= m_tokens.size() || m_tokens[index_] == "default")
+        return default_;
+
+    return std::stoi(m_tokens[index_]);
+}
+
+template <>
+float InlinedValueHandler::getParam<float>(size_t index_, const float &default_)
+{
+    if (index_ >= m_tokens.size() || m_tokens[index_] == "default")
+        return default_;
+
+    return std::stof(m_tokens[index_]);
+}
+
+
+ChatScript::ChatScript(const std::string &str_, fonts::Font &font_) :
+    m_lineHeight{font_.height()}
+{
+    std::unordered_map<uint32_t, uint32_t> glyphIds;
+
+    // Effect stacks, only their tops get to the stream
+    std::vector<CharAppearanceSpeed> speedStack(1);
+    std::vector<ChatSymbol::Effects::Shake> shakeStack(1);
+
+    // What reader will have before the next glyph
+    CharAppearanceSpeed emittedSpeed;
+    ChatSymbol::Effects::Shake emittedShake;
+
+    bool hasDelay = false;
+    uint32_t delay = 0;
+
+    size_t lineHeader = 0;
+    bool newLine = true;
+
+    bool readingCmd = false;
+    std::string cmd;
+
+    for (auto &ch : U8Wrapper(str_))
+    {
+        if (readingCmd)
+        {
+            if (ch.m_byteSize > 1)
+                throw std::runtime_error("Impossible char size in dialogue command");
+
+            if (*ch.m_ch == '>')
+            {
+                readingCmd = false;
+                InlinedValueHandler parser(cmd);
+                if (parser.getCommand() == "charspd")
+                    speedStack.emplace_back(parser.getParam<uint32_t>(0, CharAppearanceSpeed::defaultDelay), parser.getParam<uint32_t>(1, CharAppearanceSpeed::defaultDuration));
+                else if (parser.getCommand() == "/charspd" && speedStack.size() > 1)
+                    speedStack.pop_back();
+                else if (parser.getCommand() == "shake")
+                    shakeStack.emplace_back(
+                        parser.getParam<uint8_t>(0, ChatSymbol::Effects::Shake::defaultXAmp), 
+                        parser.getParam<uint8_t>(1, ChatSymbol::Effects::Shake::defaultYAmp),
+                        parser.getParam<float>(2, ChatSymbol::Effects::Shake::defaultProb));
+                else if (parser.getCommand() == "/shake" && shakeStack.size() > 1)
+                    shakeStack.pop_back();
+                else if (parser.getCommand() == "delay")
+                {
+                    delay = parser.getParam<uint8_t>(0);
+                    hasDelay = true;
+                }
+                else
+                    throw std::runtime_error(std::format("Unknown or unbalanced command \"{}\" in \"{}\"", cmd, str_));
+            }
+            else if (*ch.m_ch != ' ' && *ch.m_ch != '\t')
+                cmd += *ch.m_ch;
+
+            continue;
+        }
+
+        if (ch.m_byteSize == 1 && *ch.m_ch == '<')
+        {
+            readingCmd = true;
+            cmd = "";
+            continue;
+        }
+
+        const auto &sym = font_[ch.getu8()];
+
+        if (newLine)
+        {
+            lineHeader = m_code.size();
+            emit(ChatOp::LINE);
+            m_code.push_back(std::bit_cast<uint32_t>(sym.m_minx));
+            m_lineCount++;
+            newLine = false;
+        }
+
+        if (*ch.m_ch == '\n')
+        {
+            newLine = true;
+            continue;
+        }
+
+        const auto &speed = speedStack.back();
+        if (speed.delay != emittedSpeed.delay || speed.duration != emittedSpeed.duration)
+        {
+            emit(ChatOp::SPEED);
+            m_code.push_back(speed.delay);
+            m_code.push_back(speed.duration);
+            emittedSpeed = speed;
+        }
+
+        const auto &shake = shakeStack.back();
+        if (shake.xAmp != emittedShake.xAmp || shake.yAmp != emittedShake.yAmp || shake.prob != emittedShake.prob)
+        {
+            emit(ChatOp::SHAKE, shake.xAmp | (shake.yAmp << 8));
+            m_code.push_back(std::bit_cast<uint32_t>(shake.prob));
+            emittedShake = shake;
+        }
+
+        if (hasDelay)
+        {
+            emit(ChatOp::DELAY, delay);
+            hasDelay = false;
+        }
+
+        const auto [glyph, isNew] = glyphIds.emplace(ch.getu8(), static_cast<uint32_t>(m_glyphs.size()));
+        if (isNew)
+            m_glyphs.push_back(&sym);
+
+        emit(ChatOp::GLYPH, glyph->second);
+
+        // Symbol count of the current line
+        m_code[lineHeader] += (1 << 8);
+    }
+
+    if (readingCmd)
+        throw std::runtime_error(std::format("Unfinished command \"{}\" in \"{}\"", cmd, str_));
+}
+
+const std::vector<uint32_t> &ChatScript::getCode() const noexcept
+{
+    return m_code;
+}
+
+const fonts::Symbol &ChatScript::getGlyph(uint32_t id_) const
+{
+    return *m_glyphs[id_];
+}
+
+size_t ChatScript::getLineCount() const noexcept
+{
+    return m_lineCount;
+}
+
+int ChatScript::getLineHeight() const noexcept
+{
+    return m_lineHeight;
+}
+
+void ChatScript::emit(ChatOp op_, uint32_t operand_)
+{
+    m_code.push_back(static_cast<uint32_t>(op_) | (operand_ << 8));
+}
+
+ChatScriptLibrary &ChatScriptLibrary::instance()
+{
+    static ChatScriptLibrary lib;
+    return lib;
+}
+
+ChatScriptLibrary::ChatScriptLibrary()
+{
+    m_recent.reserve(RECENT_CAPACITY);
+    m_recentLookup.reserve(RECENT_CAPACITY);
+}
+
+const ChatScript &ChatScriptLibrary::get(const std::string &str_)
+{
+    const auto localized = m_localized.find(str_);
+    if (localized != m_localized.end())
+        return localized->second;
+
+    const auto found = m_recentLookup.find(str_);
+    if (found != m_recentLookup.end())
+    {
+        const auto entry = found->second;
+        if (entry != m_head)
+        {
+            unlink(entry);
+            pushFront(entry);
+        }
+
+        return *m_recent[entry].m_script;
+    }
+
+    // Compiled before any entry is touched, so a script that throws doesn't leave a broken entry behind
+    ChatScript script{str_, Application::instance().m_textManager.getFont(Fonts::CHATBOX)};
+
+    uint32_t entry = INVALID;
+    if (m_recent.size() < RECENT_CAPACITY)
+    {
+        entry = static_cast<uint32_t>(m_recent.size());
+        m_recent.emplace_back();
+    }
+    else
+    {
+        entry = m_tail;
+        unlink(entry);
+        m_recentLookup.erase(m_recent[entry].m_text);
+    }
+
+    auto &el = m_recent[entry];
+    el.m_text = str_;
+    el.m_script = std::move(script);
+
+    m_recentLookup[el.m_text] = entry;
+    pushFront(entry);
+
+    return *el.m_script;
+}
+
+void ChatScriptLibrary::preloadLocalization()
+{
+    m_localized.clear();
+
+    auto &font = Application::instance().m_textManager.getFont(Fonts::CHATBOX);
+    for (size_t i = 0; i < ll::count(); ++i)
+    {
+        // Localization also has UI and debug strings that were never meant to be markup, they just won't be preloaded
+        try
+        {
+            m_localized.try_emplace(ll::get(i), ll::get(i), font);
+        }
+        catch (const std::exception &ex_)
+        {
+            LOG_ERROR("Failed to compile localized string {} as a chat script: {}", i, ex_.what());
+        }
+    }
+}
+
+void ChatScriptLibrary::unlink(uint32_t entry_)
+{
+    auto &el = m_recent[entry_];
+
+    if (el.m_prev != INVALID)
+        m_recent[el.m_prev].m_next = el.m_next;
+    else
+        m_head = el.m_next;
+
+    if (el.m_next != INVALID)
+        m_recent[el.m_next].m_prev = el.m_prev;
+    else
+        m_tail = el.m_prev;
+
+    el.m_prev = INVALID;
+    el.m_next = INVALID;
+}
+
+void ChatScriptLibrary::pushFront(uint32_t entry_)
+{
+    auto &el = m_recent[entry_];
+    el.m_prev = INVALID;
+    el.m_next = m_head;
+
+    if (m_head != INVALID)
+        m_recent[m_head].m_prev = entry_;
+    else
+        m_tail = entry_;
+
+    m_head = entry_;
+}
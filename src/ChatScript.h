@@ -0,0 +1,122 @@
+#pragma once
+#include "Core/TextManager.h"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+    Utility to parse sequences of comma-separated tokens
+    Takes line like "8,default,3", lets you extract individual elements by indices.
+    "default" is a key word that forces it to pick default value.
+*/
+class InlinedValueHandler
+{
+public:
+    InlinedValueHandler(const std::string &s_);
+
+    template<typename T>
+    T getParam(size_t index_);
+
+    template<typename T>
+    T getParam(size_t index_, const T &default_);
+
+    const std::string &getCommand() const noexcept;
+
+private:
+    std::string m_command;
+    std::vector<std::string> m_tokens;
+};
+
+enum class ChatOp : uint8_t
+{
+    LINE,   // operand - amount of symbols in the line, followed by minx of the line
+    GLYPH,  // operand - index in glyph table
+    SPEED,  // followed by delay and duration
+    SHAKE,  // operand - xAmp | yAmp << 8, followed by bits of probability as float
+    DELAY   // operand - extra delay of the next glyph
+};
+
+/*
+    Chat message with its inline markup compiled into a flat stream of 32 bit words
+    Markup: <charspd=delay,duration> </charspd> <shake=xAmp,yAmp,prob> </shake> <delay=frames>, "default" picks default value
+    Effect stacks are resolved by the compiler, the stream only sets effects when they actually change
+    Glyphs are resolved against the font once, so reading the stream doesn't touch text or font at all
+    Each word is an opcode in the lowest byte and an operand in the rest
+*/
+class ChatScript
+{
+public:
+    // Throws on unknown commands and unbalanced markup
+    ChatScript(const std::string &str_, fonts::Font &font_);
+
+    const std::vector<uint32_t> &getCode() const noexcept;
+    const fonts::Symbol &getGlyph(uint32_t id_) const;
+    size_t getLineCount() const noexcept;
+    int getLineHeight() const noexcept;
+
+    static constexpr ChatOp getOp(uint32_t word_) noexcept
+    {
+        return static_cast<ChatOp>(word_ & 0xFF);
+    }
+
+    static constexpr uint32_t getOperand(uint32_t word_) noexcept
+    {
+        return word_ >> 8;
+    }
+
+private:
+    void emit(ChatOp op_, uint32_t operand_ = 0);
+
+    std::vector<uint32_t> m_code;
+    std::vector<const fonts::Symbol*> m_glyphs;
+    size_t m_lineCount = 0;
+    int m_lineHeight = 0;
+};
+
+/*
+    Compiled scripts of chat messages, strings are used as keys
+    Localized strings can be compiled all at once before any dialogue is opened and are kept for as long as the language is,
+        anything else is compiled on the first use and only the last RECENT_CAPACITY of such strings are kept
+    Returned script is only valid until the next get(), ChatMessage copies everything it needs
+*/
+class ChatScriptLibrary
+{
+public:
+    static constexpr size_t RECENT_CAPACITY = 64;
+
+    static ChatScriptLibrary &instance();
+
+    const ChatScript &get(const std::string &str_);
+
+    // Compiles every string of the current language, strings that fail to compile are logged and skipped
+    void preloadLocalization();
+
+private:
+    static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+    // Entries are an intrusive list from the most to the least recently used
+    struct RecentEntry
+    {
+        std::string m_text;
+        std::optional<ChatScript> m_script;
+        uint32_t m_prev = INVALID;
+        uint32_t m_next = INVALID;
+    };
+
+    ChatScriptLibrary();
+
+    void unlink(uint32_t entry_);
+    void pushFront(uint32_t entry_);
+
+    std::unordered_map<std::string, ChatScript> m_localized;
+
+    // Never grows past RECENT_CAPACITY, so keys pointing into entries stay valid
+    std::vector<RecentEntry> m_recent;
+    std::unordered_map<std::string_view, uint32_t> m_recentLookup;
+    uint32_t m_head = INVALID;
+    uint32_t m_tail = INVALID;
+};
@@ -7,6 +7,7 @@
 #include <nlohmann/json.hpp>
 #include "glad/glad.h"
 #include <SDL3_image/SDL_image.h>
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 
@@ -118,8 +119,9 @@ std::shared_ptr<TextureArr> AnimationManager::getTextureArr(ResID id_)
 
     std::vector<size_t> framesData(duration);
     
+    TimelineProperty<int>::Cursor cursor;
     for (uint32_t i = 0; i < duration; ++i)
-        framesData[i] = fileIdsToInternal[timelineFileIds[i]];
+        framesData[i] = fileIdsToInternal[timelineFileIds.get(i, cursor)];
 
     auto reqElem = std::make_shared<TextureArr>(std::move(texIds), surfaces.size(), std::move(framesData), surfaces[0]->w, surfaces[0]->h, origin);
     m_textureArrs[id_].m_texArr = reqElem;
@@ -155,82 +157,163 @@ ResID AnimationManager::getAnimID(const std::string &animName_) const
 TextureArr::~TextureArr()
 {
     //Logger::print("Release " + intToString(amount) + " textures\n");
-    glDeleteTextures(static_cast<int>(m_amount), m_tex.data());
+    if (Renderer::hasContext())
+        glDeleteTextures(static_cast<int>(m_amount), m_tex.data());
 }
 
-Animation::Animation(AnimationManager &animationManager_, ResID id_, LOOPMETHOD isLoop_, int beginFrame_, int beginDirection_) :
-    m_currentFrame(beginFrame_),
-    m_direction(beginDirection_),
-    m_isLoop(isLoop_)
+uint32_t Animation::m_globalTick = 0;
+
+Animation::Animation(AnimationManager &animationManager_, ResID id_, LOOPMETHOD isLoop_, int beginFrame_, int beginDirection_, AnimationTick tick_) :
+    m_beginFrame(beginFrame_),
+    m_beginDirection(beginDirection_),
+    m_isLoop(isLoop_),
+    m_tick(tick_),
+    m_startTick(m_globalTick)
 {
     m_textures = animationManager_.getTextureArr(id_);
 }
 
 void Animation::update()
 {
-    if (isFinished())
-        animFinished();
-    else
-        m_currentFrame += m_direction;
+    assert(m_tick == AnimationTick::MANUAL);
+
+    m_manualTicks++;
+}
+
+void Animation::hold()
+{
+    if (m_tick == AnimationTick::GLOBAL)
+        m_startTick++;
 }
 
 unsigned int Animation::getSprite() const
 {
-    if (m_currentFrame == -1)
-        m_currentFrame = 0;
-        
-    return (*m_textures)[m_currentFrame];
+    return (*m_textures)[evaluate().m_frame];
 }
 
-bool Animation::isFinished()
+bool Animation::isFinished() const
 {
-    if (m_direction > 0)
-        return m_currentFrame == static_cast<int>(m_textures->duration() - 1);
-    
-    return !m_currentFrame;
+    return isFinished(m_textures->duration(), evaluate());
 }
 
 void Animation::switchDir()
 {
-    m_direction *= -1;
+    auto state = evaluate();
+    state.m_direction *= -1;
+    restartFrom(state);
 }
 
 void Animation::setDir(int dir_)
 {
     assert(dir_ == 1 || dir_ == -1);
 
-    m_direction = dir_;
+    auto state = evaluate();
+    state.m_direction = dir_;
+    restartFrom(state);
 }
 
 void Animation::reset(int beginFrame_, int beginDirection_)
 {
-    m_currentFrame = beginFrame_;
-    m_direction = beginDirection_;
+    restartFrom({beginFrame_, beginDirection_});
+}
+
+int Animation::getDirection() const
+{
+    return evaluate().m_direction;
+}
+
+void Animation::advanceGlobalTick() noexcept
+{
+    m_globalTick++;
+}
+
+uint32_t Animation::getGlobalTick() noexcept
+{
+    return m_globalTick;
+}
+
+uint32_t Animation::getElapsedTicks() const noexcept
+{
+    if (m_tick == AnimationTick::MANUAL)
+        return m_manualTicks;
+
+    // Hitstop can push start tick ahead of the global one until the next tick
+    return (m_globalTick >= m_startTick ? m_globalTick - m_startTick : 0);
 }
 
-void Animation::animFinished()
+void Animation::restartFrom(const State &state_)
 {
-    switch (m_isLoop)
+    m_beginFrame = state_.m_frame;
+    m_beginDirection = state_.m_direction;
+    m_startTick = m_globalTick;
+    m_manualTicks = 0;
+}
+
+Animation::State Animation::evaluate() const
+{
+    return evaluate(m_textures->duration(), m_isLoop, {m_beginFrame, m_beginDirection}, getElapsedTicks());
+}
+
+bool Animation::isFinished(uint32_t duration_, const State &state_)
+{
+    if (state_.m_direction > 0)
+        return state_.m_frame == static_cast<int>(duration_ - 1);
+    
+    return !state_.m_frame;
+}
+
+Animation::State Animation::evaluate(uint32_t duration_, LOOPMETHOD isLoop_, const State &begin_, uint32_t ticks_)
+{
+    const int duration = static_cast<int>(duration_);
+    int64_t ticks = ticks_;
+    State state = begin_;
+
+    // Animation is always drawn before its next update, and drawing used to move it from -1 to the first frame,
+    // so an animation started from -1 shows the first frame on the tick it was started at
+    if (state.m_frame < 0)
+        state.m_frame = 0;
+
+    if (ticks == 0 || state.m_direction == 0)
+        return state;
+
+    // Updates until animation reaches its last frame in the current direction
+    const int64_t toEnd = (state.m_direction > 0 ? duration - 1 - state.m_frame : state.m_frame);
+
+    switch (isLoop_)
     {
-    case (LOOPMETHOD::NOLOOP):
-            m_direction = 0;
-        break;
-
-    case (LOOPMETHOD::JUMP_LOOP):
-        if (m_currentFrame >= static_cast<int>(m_textures->duration() - 1))
-            m_currentFrame = 0;
-        else if (m_currentFrame <= 0)
-            m_currentFrame = m_textures->duration() - 1;
-        break;
-
-    case (LOOPMETHOD::SWITCH_DIR_LOOP):
-        m_direction *= -1;
-        if (m_direction == -1)
-            m_currentFrame = m_textures->duration() - 1;
-        else
-            m_currentFrame = 0;
-        break;
+        case (LOOPMETHOD::NOLOOP):
+            if (ticks <= toEnd)
+                state.m_frame += static_cast<int>(ticks) * state.m_direction;
+            else
+                state = {(state.m_direction > 0 ? duration - 1 : 0), 0};
+            break;
+
+        case (LOOPMETHOD::JUMP_LOOP):
+            if (ticks <= toEnd)
+                state.m_frame += static_cast<int>(ticks) * state.m_direction;
+            else
+            {
+                // One update is spent jumping to the other end
+                const auto cycled = static_cast<int>((ticks - toEnd - 1) % duration);
+                state.m_frame = (state.m_direction > 0 ? cycled : duration - 1 - cycled);
+            }
+            break;
+
+        case (LOOPMETHOD::SWITCH_DIR_LOOP):
+        {
+            // Back and forth cycle takes 2 * duration updates, each end is shown twice
+            const int64_t period = 2 * duration;
+            const int64_t beginPhase = (state.m_direction > 0 ? state.m_frame : period - 1 - state.m_frame);
+            const auto phase = static_cast<int>((beginPhase + ticks) % period);
+            if (phase < duration)
+                state = {phase, 1};
+            else
+                state = {static_cast<int>(period) - 1 - phase, -1};
+            break;
+        }
     }
+
+    return state;
 }
 
 Vector2<int> Animation::getSize() const
@@ -243,8 +326,4 @@ Vector2<int> Animation::getOrigin() const
     return m_textures->m_origin;
 }
 
-int Animation::getDirection() const
-{
-    return m_direction;
-}
 
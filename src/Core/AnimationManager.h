@@ -59,19 +59,34 @@ enum class LOOPMETHOD : uint8_t
     SWITCH_DIR_LOOP
 };
 
+enum class AnimationTick : uint8_t
+{
+    GLOBAL, // Follows global tick, nothing has to be done per frame
+    MANUAL  // Only advances on update()
+};
+
 /*
     Animation class
-    Call update each frame
+    Stores only the state it was started with and the tick it was started at,
+        current frame is calculated from the elapsed ticks when it is requested
+    Global tick should be advanced once per frame, hold() keeps a global animation on its frame for a tick, used for hitstop
     Direction = 1 - direct order
     Direction = -1 - reverse order
 */
 class Animation
 {
 public:
-    Animation(AnimationManager &animationManager_, ResID id_, LOOPMETHOD isLoop_ = LOOPMETHOD::JUMP_LOOP, int beginFrame_ = -1, int beginDirection_ = 1);
+    struct State
+    {
+        int m_frame;
+        int m_direction;
+    };
+
+    Animation(AnimationManager &animationManager_, ResID id_, LOOPMETHOD isLoop_ = LOOPMETHOD::JUMP_LOOP, int beginFrame_ = -1, int beginDirection_ = 1, AnimationTick tick_ = AnimationTick::GLOBAL);
     void update();
+    void hold();
     unsigned int getSprite() const;
-    bool isFinished();
+    bool isFinished() const;
     void switchDir();
     void setDir(int dir_);
     Vector2<int> getSize() const;
@@ -79,22 +94,30 @@ public:
     void reset(int beginFrame_ = -1, int beginDirection_ = 1);
     int getDirection() const;
 
+    static void advanceGlobalTick() noexcept;
+    static uint32_t getGlobalTick() noexcept;
 
-    //Animation(Animation &anim_) = delete;
-    //Animation &operator=(Animation &anim_) = delete;
-    //Animation(Animation &&anim_);
-    //Animation &operator=(Animation &&anim_);
+    // Same state an animation started from begin_ would have after ticks_ updates, begin frame -1 is treated as 0
+    static State evaluate(uint32_t duration_, LOOPMETHOD isLoop_, const State &begin_, uint32_t ticks_);
+    static bool isFinished(uint32_t duration_, const State &state_);
 
 private:
+    State evaluate() const;
+    uint32_t getElapsedTicks() const noexcept;
+    void restartFrom(const State &state_);
+
     std::shared_ptr<TextureArr> m_textures;
 
     /*
-        Cannot be unsigned due to first frame logic:
-        on the first frame animation is used, it should show first frame no matter if the update was called or not
+        Begin frame cannot be unsigned due to first frame logic:
+        -1 means the animation shows its first frame on the tick it was started at, same as 0
     */
-    mutable int m_currentFrame;
-    int m_direction;
+    int m_beginFrame;
+    int m_beginDirection;
     LOOPMETHOD m_isLoop;
-    void animFinished();
+    AnimationTick m_tick;
+    uint32_t m_startTick = 0;
+    uint32_t m_manualTicks = 0;
 
+    static uint32_t m_globalTick;
 };
@@ -1,19 +1,52 @@
 #include "Application.h"
+#include "Configuration.h"
 #include "FilesystemUtils.h"
 #include "Localization/LocalizationGen.h"
+#include "Logger.hpp"
+#include "Profile.h"
+#include "Timer.h"
 #include "SDL3/SDL_error.h"
 
+namespace
+{
+    bool headlessMode = false;
+}
+
 Application &Application::instance()
 {
     static Application app;
     return app;
 }
 
-SDLCore::SDLCore()
+void Application::setHeadless()
+{
+    headlessMode = true;
+}
+
+bool Application::isHeadless() const noexcept
+{
+    return headlessMode;
+}
+
+SDLCore::SDLCore(bool headless_) :
+    m_headless{headless_}
 {
-    if (!SDL_Init(SDL_INIT_AUDIO | SDL_INIT_VIDEO | SDL_INIT_GAMEPAD))
+    // Gamepads don't need a display and keep event queue running
+    if (!SDL_Init(m_headless ? SDL_INIT_GAMEPAD : SDL_INIT_AUDIO | SDL_INIT_VIDEO | SDL_INIT_GAMEPAD))
         throw std::runtime_error(std::string("SDL initialization error: ") + SDL_GetError());
 
+    if (!TTF_Init())
+        throw std::runtime_error(std::string("TTF initialization error: ") + SDL_GetError());
+
+    Filesystem::ensureDirectoryRelative("Resources");
+    Filesystem::ensureDirectoryRelative("Resources/Fonts");
+
+    ll::load();
+    ll::setLang("en");
+
+    if (m_headless)
+        return;
+
     if (!SDL_GL_SetAttribute( SDL_GL_CONTEXT_MAJOR_VERSION, 4 ))
         throw std::runtime_error(std::string("Error setting SDL_GL_CONTEXT_MAJOR_VERSION: ") + SDL_GetError());
 
@@ -23,23 +56,15 @@ SDLCore::SDLCore()
     if (!SDL_GL_SetAttribute( SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE ))
         throw std::runtime_error(std::string("Error setting SDL_GL_CONTEXT_PROFILE_MASK: ") + SDL_GetError());
 
-
-    if (!TTF_Init())
-        throw std::runtime_error(std::string("TTF initialization error: ") + SDL_GetError());
-
     if (!MIX_Init())
         throw std::runtime_error(std::string("MIX initialization error: ") + SDL_GetError());
-
-    Filesystem::ensureDirectoryRelative("Resources");
-    Filesystem::ensureDirectoryRelative("Resources/Fonts");
-
-    ll::load();
-    ll::setLang("en");
 }
 
 SDLCore::~SDLCore()
 {
-    MIX_Quit();
+    if (!m_headless)
+        MIX_Quit();
+
     TTF_Quit();
     SDL_Quit();
     std::cout << "Application shut down successfully" << std::endl;
@@ -51,13 +76,20 @@ const FPSUtility &Application::getFPSUtility() const
 }
 
 Application::Application() :
-    m_window("GameName"),
+    m_sdlCore(headlessMode),
+    m_window("GameName", headlessMode),
     m_renderer(m_window),
     m_textManager(m_renderer),
     m_fpsUtility{60}
 {
     Filesystem::ensureDirectoryRelative("Tilemaps");
     Filesystem::ensureDirectoryRelative("Configs");
+
+    const auto logLevel = ConfigurationManager::instance().m_settings["log_level"].readOrSet<std::string>(serialize(Logger::Level::TRACE));
+    if (makeReversedMap<Logger::Level>().contains(logLevel))
+        Logger::setLevel(deserialize<Logger::Level>(logLevel));
+    else
+        LOG_WARNING("Unknown log level \"{}\", expected TRC, INF, WRN or ERR", logLevel);
 }
 
 void Application::run()
@@ -69,3 +101,69 @@ void Application::run()
         m_levelResult = m_levels[*m_levelResult.nextLvl]->proceed();
     }
 }
+
+void Application::record(const std::string &path_)
+{
+    m_inputSession.startRecording(path_);
+    run();
+}
+
+void Application::replay(const std::string &path_)
+{
+    m_inputSession.startReplay(path_);
+
+    const auto &lvlname = m_inputSession.getReplayLevel();
+    if (!m_levels.contains(lvlname))
+        throw std::runtime_error(std::format("Cannot replay level \"{}\": level does not exist", lvlname));
+
+    m_window.hide();
+    m_fpsUtility.setUncapped(true);
+    m_levelResult.nextLvl = lvlname;
+
+    Timer tmr;
+    tmr.begin();
+    run();
+
+    LOG_INFO("Replay finished in {}ms", static_cast<float>(tmr.getPassed()) / 1'000'000.0f);
+}
+
+void Application::simulate(const SimulationConfig &config_)
+{
+    auto levelName = config_.m_level.empty() ? m_levelResult.nextLvl.value_or("") : config_.m_level;
+    if (!config_.m_replay.empty())
+    {
+        m_inputSession.startReplay(config_.m_replay);
+        levelName = m_inputSession.getReplayLevel();
+    }
+
+    if (!m_levels.contains(levelName))
+        throw std::runtime_error(std::format("Cannot simulate level \"{}\": level does not exist", levelName));
+
+    auto &level = *m_levels[levelName];
+    auto &profiler = Profiler::instance();
+    SimulationStats stats;
+    Timer frameTimer;
+
+    level.enter();
+
+    // Level loading is not a part of any frame
+    profiler.cleanFrame();
+
+    bool running = true;
+    for (uint32_t frame = 0; frame < config_.m_frames && running; ++frame)
+    {
+        frameTimer.begin();
+        running = level.simulateFrame();
+        const auto frameTime = frameTimer.getPassed();
+
+        profiler.cleanFrame();
+        stats.collect(frameTime);
+        m_frameTelemetry.addFrame({.m_update = frameTime});
+    }
+
+    level.leave();
+
+    stats.dump(levelName);
+    if (!config_.m_output.empty())
+        stats.save(config_.m_output);
+}
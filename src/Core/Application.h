@@ -7,6 +7,9 @@
 #include "AnimationManager.h"
 #include "TextManager.h"
 #include "FPSUtility.h"
+#include "InputRecording.h"
+#include "FrameTelemetry.h"
+#include "Simulation.h"
 #include <memory>
 #include <SDL3_mixer/SDL_mixer.h>
 
@@ -18,8 +21,12 @@ namespace gamedata::levels
 class SDLCore
 {
 public:
-    SDLCore();
+    // Headless core does not initialize video and audio
+    SDLCore(bool headless_);
     ~SDLCore();
+
+private:
+    const bool m_headless;
 };
 
 class Application
@@ -29,8 +36,22 @@ private:
 
 public:
     static Application &instance();
+
+    // Application will have no window, null renderer and null text manager, should be called before the first instance() call
+    static void setHeadless();
+    bool isHeadless() const noexcept;
+
     void run();
 
+    // Same as run, but inputs of the first entered level are saved to file
+    void record(const std::string &path_);
+
+    // Runs recorded level with recorded inputs as fast as possible with hidden window, exits when inputs run out
+    void replay(const std::string &path_);
+
+    // Runs only level updates as fast as possible and reports per-system timings, meant for headless mode
+    void simulate(const SimulationConfig &config_);
+
     template<typename T, typename... Args>
     void makeLevel(Args&&... args_) 
         requires std::constructible_from<T, FPSUtility&, Args...>;
@@ -50,6 +71,8 @@ public:
     TextureManager m_textureManager;
     AnimationManager m_animationManager;
     TextManager m_textManager;
+    InputSession m_inputSession;
+    FrameTelemetry m_frameTelemetry;
 
 private:
     Application();
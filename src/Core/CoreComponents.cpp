@@ -153,39 +153,6 @@ RenderLayer::RenderLayer(int depth_, bool visible_) noexcept :
     m_depth(depth_),
     m_visible(visible_)
 {
-    m_dirtyOrder = true;
-}
-
-RenderLayer::RenderLayer(const RenderLayer &rhs_) noexcept :
-    m_depth(rhs_.m_depth),
-    m_visible(rhs_.m_visible)
-{
-    m_dirtyOrder = true;
-}
-
-RenderLayer::RenderLayer(RenderLayer &&rhs_) noexcept :
-    m_depth(rhs_.m_depth),
-    m_visible(rhs_.m_visible)
-{
-    m_dirtyOrder = true;
-}
-
-RenderLayer &RenderLayer::operator=(const RenderLayer &rhs_) noexcept
-{
-    m_depth = rhs_.m_depth;
-    m_visible = rhs_.m_visible;
-    m_dirtyOrder = true;
-
-    return *this;
-}
-
-RenderLayer &RenderLayer::operator=(RenderLayer &&rhs_) noexcept
-{
-    m_depth = rhs_.m_depth;
-    m_visible = rhs_.m_visible;
-    m_dirtyOrder = true;
-
-    return *this;
 }
 
 int RenderLayer::getDepth() const noexcept
@@ -198,13 +165,6 @@ bool RenderLayer::isVisible() const noexcept
     return m_visible;
 }
 
-RenderLayer::~RenderLayer()
-{
-    m_dirtyOrder = true;
-}
-
-bool RenderLayer::m_dirtyOrder = false;
-
 MoveCollider2Points::MoveCollider2Points(const Vector2<int> &offset_) :
     m_offset(offset_)
 {
@@ -212,7 +172,6 @@ MoveCollider2Points::MoveCollider2Points(const Vector2<int> &offset_) :
 
 T_NAME_AUTO(ComponentTransform);
 T_NAME_AUTO(const ComponentTransform);
-T_NAME_AUTO(ComponentParticlePrimitive);
 T_NAME_AUTO(ComponentSpawnLocation);
 T_NAME_AUTO(ComponentPhysical);
 T_NAME_AUTO(const ComponentPhysical);
@@ -9,6 +9,7 @@
 #include "NavSystem.h"
 #include <entt/entt.hpp>
 #include <set>
+#include <limits>
 #include <map>
 #include <memory>
 #include <utility>
@@ -237,17 +238,10 @@ struct HUDPoint
 struct RenderLayer
 {
     RenderLayer(int depth_, bool visible_ = true) noexcept;
-    RenderLayer(const RenderLayer&) noexcept;
-    RenderLayer(RenderLayer&&) noexcept;
-    RenderLayer &operator=(const RenderLayer&) noexcept;
-    RenderLayer &operator=(RenderLayer&&) noexcept;
-    ~RenderLayer();
 
     int getDepth() const noexcept;
     bool isVisible() const noexcept;
 
-    static bool m_dirtyOrder;
-
 private:
     int m_depth;
     bool m_visible = true;
@@ -275,16 +269,19 @@ struct TilemapLayer
     Vector2<int> m_posOffset;
 };
 
-struct ComponentParticlePrimitive
+// Pooled particle, becomes stale once the particle expires
+struct ParticleHandle
 {
-    FrameTimer<false> lifetime;
-    float angle = 0.0f;
-    entt::entity tieTransform = entt::null;
+    static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+    uint32_t m_pool = INVALID;
+    uint32_t m_slot = INVALID;
+    uint32_t m_generation = 0;
 };
 
 struct ComponentChildParticles
 {
-    std::vector<entt::entity> destroyOnStateChange;
+    std::vector<ParticleHandle> destroyOnStateChange;
 };
 
 Collider getColliderAt(const Collider &col_, const ComponentTransform &trans_);
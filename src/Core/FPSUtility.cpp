@@ -20,6 +20,11 @@ void FPSUtility::setDefaultFPS()
     m_properFrameDurationNS = m_defaultProperFrameDurationNS;
 }
 
+void FPSUtility::setUncapped(bool uncapped_)
+{
+    m_uncapped = uncapped_;
+}
+
 void FPSUtility::start()
 {
     updateSyncPoint();
@@ -40,6 +45,13 @@ void FPSUtility::cycle()
     // Debug only
     lastCycleCalls[1] = lastCycleCalls[0];
     lastCycleCalls[0] = currentTS;
+    m_lastSleepNS = 0;
+
+    if (m_uncapped)
+    {
+        m_lastSyncPointNS = currentTS;
+        return;
+    }
 
     if (frameDur <= m_properFrameDurationNS) // Frame was faster or exactly as necessary
     {
@@ -47,6 +59,7 @@ void FPSUtility::cycle()
         
         m_lastSyncPointNS += m_properFrameDurationNS;
         SDL_DelayPrecise(m_properFrameDurationNS - frameDur);
+        m_lastSleepNS = SDL_GetTicksNS() - currentTS;
     }
     else
     {
@@ -61,3 +74,13 @@ void FPSUtility::cycle()
         }
     }
 }
+
+uint64_t FPSUtility::getFrameDuration() const noexcept
+{
+    return m_properFrameDurationNS;
+}
+
+uint64_t FPSUtility::getLastSleepDuration() const noexcept
+{
+    return m_lastSleepNS;
+}
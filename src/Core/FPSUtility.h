@@ -14,6 +14,9 @@ public:
     void setFPS(uint64_t targettedFPS_);
     void setDefaultFPS();
 
+    // Never sleep, for replays and benchmarks. Overrides any FPS setting
+    void setUncapped(bool uncapped_);
+
     void start();
     
     /**
@@ -21,6 +24,11 @@ public:
      */
     void cycle();
 
+    uint64_t getFrameDuration() const noexcept;
+
+    // Time spent sleeping during the last cycle call
+    uint64_t getLastSleepDuration() const noexcept;
+
     // Debug only
     std::array<uint64_t, 2> lastCycleCalls;
     
@@ -30,5 +38,7 @@ private:
     constexpr static uint64_t s_syncLimit = 5;
     uint64_t m_lastSyncPointNS = 0;
     uint64_t m_properFrameDurationNS = 0;
+    uint64_t m_lastSleepNS = 0;
+    bool m_uncapped = false;
     const uint64_t m_defaultProperFrameDurationNS = 0;
 };
@@ -0,0 +1,245 @@
+#include "FrameTelemetry.h"
+#include "Configuration.h"
+#include "FilesystemUtils.h"
+#include "Logger.hpp"
+#include <algorithm>
+#include <bit>
+#include <ctime>
+#include <filesystem>
+#include <format>
+
+namespace
+{
+    constexpr uint32_t telemetryMagic = 0x4C455446; // "FTEL"
+    constexpr uint16_t telemetryVersion = 1;
+
+    template<typename T>
+    void writeValue(std::ofstream &out_, const T &value_)
+    {
+        out_.write(reinterpret_cast<const char*>(&value_), sizeof(T));
+    }
+
+    float toMs(uint64_t ns_)
+    {
+        return static_cast<float>(ns_) / 1'000'000.0f;
+    }
+}
+
+uint64_t FrameTimes::work() const noexcept
+{
+    return m_update + m_draw + m_swap;
+}
+
+size_t FrameHistogram::bucketOf(uint64_t value_) noexcept
+{
+    if (value_ < SUB_BUCKETS)
+        return static_cast<size_t>(value_);
+
+    // Top SUB_BUCKET_BITS + 1 bits of the value select the bucket, the rest is precision we don't keep
+    const auto shift = static_cast<uint32_t>(std::bit_width(value_)) - 1 - SUB_BUCKET_BITS;
+    return SUB_BUCKETS + shift * SUB_BUCKETS + static_cast<size_t>((value_ >> shift) - SUB_BUCKETS);
+}
+
+uint64_t FrameHistogram::bucketUpperBound(size_t bucket_) noexcept
+{
+    if (bucket_ < SUB_BUCKETS)
+        return bucket_;
+
+    const auto shift = (bucket_ - SUB_BUCKETS) / SUB_BUCKETS;
+    const auto sub = (bucket_ - SUB_BUCKETS) % SUB_BUCKETS;
+    const uint64_t lower = (uint64_t{SUB_BUCKETS} + sub) << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+}
+
+void FrameHistogram::add(uint64_t value_) noexcept
+{
+    m_buckets[bucketOf(value_)]++;
+    m_count++;
+    m_max = std::max(m_max, value_);
+}
+
+void FrameHistogram::reset() noexcept
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_max = 0;
+}
+
+uint64_t FrameHistogram::percentile(float percentile_) const noexcept
+{
+    if (m_count == 0)
+        return 0;
+
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(static_cast<double>(m_count) * percentile_ / 100.0 + 0.999999));
+    uint64_t passed = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        passed += m_buckets[i];
+        if (passed >= rank)
+            return std::min(bucketUpperBound(i), m_max);
+    }
+
+    return m_max;
+}
+
+uint64_t FrameHistogram::max() const noexcept
+{
+    return m_max;
+}
+
+uint64_t FrameHistogram::count() const noexcept
+{
+    return m_count;
+}
+
+FrameTelemetry::FrameTelemetry()
+{
+    auto conf = ConfigurationManager::instance().m_settings["telemetry"];
+    m_outputDirectory = conf["output"].readOrSet<std::string>("Telemetry");
+
+    const auto format = conf["format"].readOrSet<std::string>("none");
+    if (format == "csv")
+        m_format = TelemetryFormat::CSV;
+    else if (format == "binary")
+        m_format = TelemetryFormat::BINARY;
+    else if (format != "none")
+        LOG_WARNING("Unknown telemetry format \"{}\", expected \"csv\", \"binary\" or \"none\"", format);
+}
+
+void FrameTelemetry::beginLevel(const std::string &levelName_, uint64_t frameBudget_)
+{
+    m_levelName = levelName_;
+    m_frameBudget = frameBudget_;
+    m_frameCount = 0;
+    m_hitchCount = 0;
+    m_ring.fill({});
+    for (auto &histogram : m_histograms)
+        histogram.reset();
+
+    m_levelActive = true;
+    openOutput();
+}
+
+void FrameTelemetry::endLevel()
+{
+    if (!m_levelActive)
+        return;
+
+    m_levelActive = false;
+    m_output.close();
+
+    const auto &work = getHistogram(Phase::WORK);
+    LOG_INFO("Level \"{}\": {} frames, {} hitches, work p50 {}ms, p99 {}ms, max {}ms",
+        m_levelName, m_frameCount, m_hitchCount, toMs(work.percentile(50.0f)), toMs(work.percentile(99.0f)), toMs(work.max()));
+
+    if (m_format != TelemetryFormat::NONE)
+        writeSummary();
+}
+
+void FrameTelemetry::addFrame(const FrameTimes &frame_)
+{
+    m_ring[m_frameCount % RING_SIZE] = frame_;
+    m_frameCount++;
+
+    const auto work = frame_.work();
+    m_histograms[static_cast<size_t>(Phase::UPDATE)].add(frame_.m_update);
+    m_histograms[static_cast<size_t>(Phase::DRAW)].add(frame_.m_draw);
+    m_histograms[static_cast<size_t>(Phase::SWAP)].add(frame_.m_swap);
+    m_histograms[static_cast<size_t>(Phase::SLEEP)].add(frame_.m_sleep);
+    m_histograms[static_cast<size_t>(Phase::WORK)].add(work);
+
+    if (work > m_frameBudget)
+        m_hitchCount++;
+
+    if (m_output.is_open())
+        writeFrame(frame_);
+}
+
+const FrameTimes &FrameTelemetry::getFrame(size_t framesAgo_) const noexcept
+{
+    static const FrameTimes empty;
+    if (framesAgo_ >= RING_SIZE || framesAgo_ >= m_frameCount)
+        return empty;
+
+    return m_ring[(m_frameCount - 1 - framesAgo_) % RING_SIZE];
+}
+
+const FrameHistogram &FrameTelemetry::getHistogram(Phase phase_) const noexcept
+{
+    return m_histograms[static_cast<size_t>(phase_)];
+}
+
+uint64_t FrameTelemetry::getHitchCount() const noexcept
+{
+    return m_hitchCount;
+}
+
+void FrameTelemetry::openOutput()
+{
+    if (m_format == TelemetryFormat::NONE)
+        return;
+
+    const auto directory = Filesystem::getRootDirectory() + m_outputDirectory + "/";
+    std::filesystem::create_directories(directory);
+
+    const auto path = std::format("{}{}_{}.{}", directory, m_levelName, std::time(nullptr), (m_format == TelemetryFormat::CSV ? "csv" : "bin"));
+    if (m_format == TelemetryFormat::CSV)
+    {
+        m_output.open(path);
+        if (m_output.is_open())
+            m_output << "frame,update_ns,draw_ns,swap_ns,sleep_ns\n";
+    }
+    else
+    {
+        m_output.open(path, std::ios::binary);
+        if (m_output.is_open())
+        {
+            writeValue(m_output, telemetryMagic);
+            writeValue(m_output, telemetryVersion);
+            writeValue(m_output, m_frameBudget);
+            writeValue(m_output, static_cast<uint16_t>(m_levelName.size()));
+            m_output.write(m_levelName.data(), static_cast<std::streamsize>(m_levelName.size()));
+        }
+    }
+
+    if (!m_output.is_open())
+        LOG_WARNING("Failed to open \"{}\", frame telemetry will not be saved", path);
+}
+
+void FrameTelemetry::writeFrame(const FrameTimes &frame_)
+{
+    if (m_format == TelemetryFormat::CSV)
+    {
+        std::format_to(std::ostreambuf_iterator<char>(m_output), "{},{},{},{},{}\n",
+            m_frameCount - 1, frame_.m_update, frame_.m_draw, frame_.m_swap, frame_.m_sleep);
+    }
+    else
+    {
+        writeValue(m_output, frame_.m_update);
+        writeValue(m_output, frame_.m_draw);
+        writeValue(m_output, frame_.m_swap);
+        writeValue(m_output, frame_.m_sleep);
+    }
+}
+
+void FrameTelemetry::writeSummary() const
+{
+    const auto path = Filesystem::getRootDirectory() + m_outputDirectory + "/summary.csv";
+    const bool exists = std::filesystem::exists(path);
+
+    std::ofstream out(path, std::ios::app);
+    if (!out.is_open())
+    {
+        LOG_WARNING("Failed to open \"{}\" to save telemetry summary", path);
+        return;
+    }
+
+    if (!exists)
+        out << "level,time,frames,hitches,work_p50_ns,work_p99_ns,work_max_ns,update_p99_ns,draw_p99_ns,swap_p99_ns\n";
+
+    const auto &work = getHistogram(Phase::WORK);
+    std::format_to(std::ostreambuf_iterator<char>(out), "{},{},{},{},{},{},{},{},{},{}\n",
+        m_levelName, std::time(nullptr), m_frameCount, m_hitchCount,
+        work.percentile(50.0f), work.percentile(99.0f), work.max(),
+        getHistogram(Phase::UPDATE).percentile(99.0f), getHistogram(Phase::DRAW).percentile(99.0f), getHistogram(Phase::SWAP).percentile(99.0f));
+}
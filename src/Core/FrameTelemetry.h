@@ -0,0 +1,106 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+// Where the frame time went, all values are in nanoseconds
+struct FrameTimes
+{
+    uint64_t m_update = 0;
+    uint64_t m_draw = 0;
+    uint64_t m_swap = 0;
+    uint64_t m_sleep = 0;
+
+    // Time actually spent on the frame, without sleeping
+    uint64_t work() const noexcept;
+};
+
+/*
+    Log-linear histogram in the spirit of HdrHistogram
+    Each power of two is split into SUB_BUCKETS linear buckets, so the relative error stays below 1/SUB_BUCKETS for any value
+    Fixed size, recording is a couple of bit operations
+*/
+class FrameHistogram
+{
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 4;
+    static constexpr uint32_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    void add(uint64_t value_) noexcept;
+    void reset() noexcept;
+
+    // Upper bound of the bucket containing the requested percentile
+    uint64_t percentile(float percentile_) const noexcept;
+    uint64_t max() const noexcept;
+    uint64_t count() const noexcept;
+
+    static size_t bucketOf(uint64_t value_) noexcept;
+    static uint64_t bucketUpperBound(size_t bucket_) noexcept;
+
+private:
+    std::array<uint32_t, BUCKET_COUNT> m_buckets = {};
+    uint64_t m_count = 0;
+    uint64_t m_max = 0;
+};
+
+enum class TelemetryFormat : uint8_t
+{
+    NONE,
+    CSV,
+    BINARY
+};
+
+/*
+    Collects timings of every frame of a level
+    Keeps last RING_SIZE frames in memory, histograms for the whole level and optionally streams every frame to a file
+    Output is configured in settings: "telemetry": {"output": "Telemetry", "format": "csv" | "binary" | "none"}
+    Summary with percentiles and hitch count is logged and appended to summary.csv in the output directory when level ends
+*/
+class FrameTelemetry
+{
+public:
+    static constexpr size_t RING_SIZE = 1024;
+
+    enum class Phase : uint8_t
+    {
+        UPDATE,
+        DRAW,
+        SWAP,
+        SLEEP,
+        WORK,
+        COUNT
+    };
+
+    FrameTelemetry();
+
+    // Frame is considered a hitch if it's work took longer than frameBudget_
+    void beginLevel(const std::string &levelName_, uint64_t frameBudget_);
+    void endLevel();
+
+    void addFrame(const FrameTimes &frame_);
+
+    // Index 0 is the last frame, returns empty frame if it's older than ring
+    const FrameTimes &getFrame(size_t framesAgo_) const noexcept;
+    const FrameHistogram &getHistogram(Phase phase_) const noexcept;
+    uint64_t getHitchCount() const noexcept;
+
+private:
+    void openOutput();
+    void writeFrame(const FrameTimes &frame_);
+    void writeSummary() const;
+
+    std::array<FrameTimes, RING_SIZE> m_ring = {};
+    uint64_t m_frameCount = 0;
+
+    std::array<FrameHistogram, static_cast<size_t>(Phase::COUNT)> m_histograms;
+    uint64_t m_hitchCount = 0;
+    uint64_t m_frameBudget = 0;
+    std::string m_levelName;
+    bool m_levelActive = false;
+
+    std::string m_outputDirectory;
+    TelemetryFormat m_format = TelemetryFormat::NONE;
+    std::ofstream m_output;
+};
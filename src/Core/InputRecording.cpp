@@ -0,0 +1,212 @@
+#include "InputRecording.h"
+#include "Logger.hpp"
+#include <cstdlib>
+#include <ctime>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    constexpr uint32_t recordingMagic = 0x43455249; // "IREC"
+    constexpr uint16_t recordingVersion = 1;
+
+    template<typename T>
+    void writeValue(std::ofstream &out_, const T &value_)
+    {
+        out_.write(reinterpret_cast<const char*>(&value_), sizeof(T));
+    }
+
+    template<typename T>
+    T readValue(std::ifstream &in_, const std::string &path_)
+    {
+        T value{};
+        if (!in_.read(reinterpret_cast<char*>(&value), sizeof(T)))
+            throw std::runtime_error(std::format("Input recording \"{}\" is truncated", path_));
+
+        return value;
+    }
+}
+
+void InputRecording::save(const std::string &path_) const
+{
+    std::ofstream out(path_, std::ios::binary);
+    if (!out.is_open())
+        throw std::runtime_error(std::format("Failed to open \"{}\" to save input recording", path_));
+
+    writeValue(out, recordingMagic);
+    writeValue(out, recordingVersion);
+    writeValue(out, m_seed);
+    writeValue(out, static_cast<uint16_t>(m_levelName.size()));
+    out.write(m_levelName.data(), static_cast<std::streamsize>(m_levelName.size()));
+    writeValue(out, static_cast<uint32_t>(m_frames.size()));
+
+    // Pairs of (input word, number of repeats)
+    size_t i = 0;
+    while (i < m_frames.size())
+    {
+        const auto word = m_frames[i].m_inputs;
+        uint16_t run = 1;
+        while (i + run < m_frames.size() && m_frames[i + run].m_inputs == word && run < std::numeric_limits<uint16_t>::max())
+            run++;
+
+        writeValue(out, word);
+        writeValue(out, run);
+        i += run;
+    }
+}
+
+InputRecording InputRecording::load(const std::string &path_)
+{
+    std::ifstream in(path_, std::ios::binary);
+    if (!in.is_open())
+        throw std::runtime_error(std::format("Failed to open input recording \"{}\"", path_));
+
+    if (readValue<uint32_t>(in, path_) != recordingMagic)
+        throw std::runtime_error(std::format("\"{}\" is not an input recording", path_));
+
+    const auto version = readValue<uint16_t>(in, path_);
+    if (version != recordingVersion)
+        throw std::runtime_error(std::format("Input recording \"{}\" has unsupported version {}", path_, version));
+
+    InputRecording res;
+    res.m_seed = readValue<uint32_t>(in, path_);
+
+    res.m_levelName.resize(readValue<uint16_t>(in, path_));
+    if (!in.read(res.m_levelName.data(), static_cast<std::streamsize>(res.m_levelName.size())))
+        throw std::runtime_error(std::format("Input recording \"{}\" is truncated", path_));
+
+    const auto frameCount = readValue<uint32_t>(in, path_);
+    res.m_frames.reserve(frameCount);
+    while (res.m_frames.size() < frameCount)
+    {
+        const auto word = readValue<uint16_t>(in, path_);
+        const auto run = readValue<uint16_t>(in, path_);
+        if (run == 0 || res.m_frames.size() + run > frameCount)
+            throw std::runtime_error(std::format("Input recording \"{}\" is corrupted", path_));
+
+        res.m_frames.insert(res.m_frames.end(), run, InputState{word});
+    }
+
+    return res;
+}
+
+void InputSession::startRecording(const std::string &path_)
+{
+    m_mode = InputSessionMode::RECORD;
+    m_path = path_;
+    m_recording = InputRecording{};
+    m_recording.m_seed = static_cast<uint32_t>(std::time(nullptr));
+
+    LOG_INFO("Recording inputs to \"{}\" with seed {}", m_path, m_recording.m_seed);
+}
+
+void InputSession::startReplay(const std::string &path_)
+{
+    m_mode = InputSessionMode::REPLAY;
+    m_path = path_;
+    m_recording = InputRecording::load(path_);
+
+    LOG_INFO("Replaying \"{}\": level \"{}\", seed {}, {} frames", m_path, m_recording.m_levelName, m_recording.m_seed, m_recording.m_frames.size());
+}
+
+void InputSession::beginLevel(const std::string &levelName_)
+{
+    if (m_mode == InputSessionMode::LIVE)
+        return;
+
+    // Only the first entered level gets recorded
+    if (m_mode == InputSessionMode::RECORD)
+    {
+        if (!m_recording.m_levelName.empty())
+        {
+            m_mode = InputSessionMode::LIVE;
+            return;
+        }
+
+        m_recording.m_levelName = levelName_;
+    }
+    else if (levelName_ != m_recording.m_levelName)
+        throw std::runtime_error(std::format("Input recording \"{}\" was made for level \"{}\", not \"{}\"", m_path, m_recording.m_levelName, levelName_));
+
+    std::srand(m_recording.m_seed);
+    m_currentFrame = 0;
+    m_levelActive = true;
+}
+
+void InputSession::endLevel()
+{
+    if (!m_levelActive)
+        return;
+
+    m_levelActive = false;
+
+    if (m_mode == InputSessionMode::RECORD)
+    {
+        m_recording.save(m_path);
+        LOG_INFO("Saved {} frames of inputs to \"{}\"", m_recording.m_frames.size(), m_path);
+    }
+}
+
+InputState InputSession::processFrame(const InputState &liveInput_)
+{
+    if (!m_levelActive)
+        return liveInput_;
+
+    switch (m_mode)
+    {
+        case (InputSessionMode::RECORD):
+            m_recording.m_frames.push_back(liveInput_);
+            m_currentFrame++;
+            return liveInput_;
+
+        case (InputSessionMode::REPLAY):
+            if (m_currentFrame < m_recording.m_frames.size())
+                return m_recording.m_frames[m_currentFrame++];
+            return InputState{};
+
+        default:
+            return liveInput_;
+    }
+}
+
+bool InputSession::isEventAllowed(GAMEPLAY_EVENTS ev_) const noexcept
+{
+    if (!m_levelActive || m_mode == InputSessionMode::LIVE)
+        return true;
+
+    switch (ev_)
+    {
+        case (GAMEPLAY_EVENTS::QUIT):
+        case (GAMEPLAY_EVENTS::UP):
+        case (GAMEPLAY_EVENTS::RIGHT):
+        case (GAMEPLAY_EVENTS::DOWN):
+        case (GAMEPLAY_EVENTS::LEFT):
+        case (GAMEPLAY_EVENTS::ATTACK):
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool InputSession::isEventAllowed(HUD_EVENTS) const noexcept
+{
+    return !m_levelActive || m_mode == InputSessionMode::LIVE;
+}
+
+InputSessionMode InputSession::getMode() const noexcept
+{
+    return m_mode;
+}
+
+const std::string &InputSession::getReplayLevel() const noexcept
+{
+    return m_recording.m_levelName;
+}
+
+bool InputSession::isReplayFinished() const noexcept
+{
+    return m_mode == InputSessionMode::REPLAY && m_currentFrame >= m_recording.m_frames.size();
+}
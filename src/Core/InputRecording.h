@@ -0,0 +1,65 @@
+#pragma once
+#include "InputState.h"
+#include "InputSystem.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+    Everything required to repeat a single level run: level name, RNG seed and inputs for every simulated frame
+    Stored as a small binary file, frames are run-length encoded since inputs rarely change between frames
+*/
+struct InputRecording
+{
+    std::string m_levelName;
+    uint32_t m_seed = 0;
+    std::vector<InputState> m_frames;
+
+    void save(const std::string &path_) const;
+    static InputRecording load(const std::string &path_);
+};
+
+enum class InputSessionMode : uint8_t
+{
+    LIVE,
+    RECORD,
+    REPLAY
+};
+
+/*
+    Sits between the input system and InputResolvers
+    In record mode passes live inputs through while storing them, in replay mode ignores live inputs entirely
+*/
+class InputSession
+{
+public:
+    void startRecording(const std::string &path_);
+    void startReplay(const std::string &path_);
+
+    // Seeds RNG and resets frame counter, should be called when level is entered
+    void beginLevel(const std::string &levelName_);
+
+    // Saves recording, if any
+    void endLevel();
+
+    // Returns input that should be used for the current simulated frame
+    InputState processFrame(const InputState &liveInput_);
+
+    /*
+        Only InputState is recorded, so while a level is recorded or replayed everything else is blocked except QUIT:
+        pause and frame stepping would desync frames, debug dialogues and HUD input would desync rand()
+    */
+    bool isEventAllowed(GAMEPLAY_EVENTS ev_) const noexcept;
+    bool isEventAllowed(HUD_EVENTS ev_) const noexcept;
+
+    InputSessionMode getMode() const noexcept;
+    const std::string &getReplayLevel() const noexcept;
+    bool isReplayFinished() const noexcept;
+
+private:
+    InputSessionMode m_mode = InputSessionMode::LIVE;
+    InputRecording m_recording;
+    std::string m_path;
+    size_t m_currentFrame = 0;
+    bool m_levelActive = false;
+};
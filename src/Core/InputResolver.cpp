@@ -2,231 +2,177 @@
 #include "GameData.h"
 #include "InputState.h"
 #include "Vector2.hpp"
+#include <format>
+#include <stdexcept>
 
-InputResolver::InputResolver() :
-    m_inputComparators {
-        {InputMotions::HOLD_HORDIR, &InputResolver::checkHoldHorDir},
-        {InputMotions::CHECK_NO_HORDIR, &InputResolver::checkNoHorDir},
-        {InputMotions::HOLD_HORDIR_BUFFERED, &InputResolver::checkBufferedHoldHorDir},
+namespace
+{
+    /*
+        All bits at and above the lowest set bit, 0 if nothing is set
+        Turns "happened at frame i" into "happened at frame i or any newer frame"
+    */
+    constexpr uint32_t fillOlder(uint32_t mask_)
+    {
+        return mask_ | ~(mask_ - 1);
+    }
+}
 
-        {InputMotions::TAP_ANY_EXCEPT_BACKWARDS, &InputResolver::checkTapExceptBackwards},
+const std::array<InputResolver::InputCheck, InputResolver::MOTIONS_COUNT> InputResolver::m_inputComparators = []()
+{
+    std::array<InputCheck, MOTIONS_COUNT> comparators{};
 
-        {InputMotions::HOLD_UP, &InputResolver::checkHoldUp},
-        {InputMotions::BUFFER_UP, &InputResolver::checkBufferUp},
-        {InputMotions::BUFFER_UP_STRICT, &InputResolver::checkBufferUpStrict},
+    comparators[static_cast<size_t>(InputMotions::HOLD_HORDIR)] = &InputResolver::checkHoldHorDir;
+    comparators[static_cast<size_t>(InputMotions::CHECK_NO_HORDIR)] = &InputResolver::checkNoHorDir;
+    comparators[static_cast<size_t>(InputMotions::HOLD_HORDIR_BUFFERED)] = &InputResolver::checkBufferedHoldHorDir;
 
-        {InputMotions::HOLD_UP_FORWARD, &InputResolver::checkHoldUpForward},
-        {InputMotions::BUFFER_UP_FORWARD, &InputResolver::checkBufferUpForward},
-        {InputMotions::BUFFER_UP_FORWARD_STRICT, &InputResolver::checkBufferUpForwardStrict},
+    comparators[static_cast<size_t>(InputMotions::TAP_ANY_EXCEPT_BACKWARDS)] = &InputResolver::checkTapExceptBackwards;
 
-        {InputMotions::BUFFERED_ORIENTED_ATTACK, &InputResolver::checkBufferedOrientedAttack},
-    }
-{}
+    comparators[static_cast<size_t>(InputMotions::HOLD_UP)] = &InputResolver::checkHoldUp;
+    comparators[static_cast<size_t>(InputMotions::BUFFER_UP)] = &InputResolver::checkBufferUp;
+    comparators[static_cast<size_t>(InputMotions::BUFFER_UP_STRICT)] = &InputResolver::checkBufferUpStrict;
+
+    comparators[static_cast<size_t>(InputMotions::HOLD_UP_FORWARD)] = &InputResolver::checkHoldUpForward;
+    comparators[static_cast<size_t>(InputMotions::BUFFER_UP_FORWARD)] = &InputResolver::checkBufferUpForward;
+    comparators[static_cast<size_t>(InputMotions::BUFFER_UP_FORWARD_STRICT)] = &InputResolver::checkBufferUpForwardStrict;
+
+    comparators[static_cast<size_t>(InputMotions::BUFFERED_ORIENTED_ATTACK)] = &InputResolver::checkBufferedOrientedAttack;
+
+    return comparators;
+}();
 
 void InputResolver::addFrame(const InputState &currentInput_)
 {
     m_inputQueue.push(currentInput_);
+
+    const auto dir = currentInput_.getDir();
+    const auto pushPlane = [this](InputPlane plane_, bool value_) {
+        auto &mask = m_planes[static_cast<size_t>(plane_)];
+        mask = (mask << 1) | (value_ ? 1 : 0);
+    };
+
+    pushPlane(InputPlane::PRESENT, true);
+
+    pushPlane(InputPlane::PRESSED_UP, currentInput_.getButton(INPUT_BUTTON::UP) == INPUT_BUTTON_STATE::PRESSED);
+    pushPlane(InputPlane::PRESSED_DOWN, currentInput_.getButton(INPUT_BUTTON::DOWN) == INPUT_BUTTON_STATE::PRESSED);
+    pushPlane(InputPlane::PRESSED_LEFT, currentInput_.getButton(INPUT_BUTTON::LEFT) == INPUT_BUTTON_STATE::PRESSED);
+    pushPlane(InputPlane::PRESSED_RIGHT, currentInput_.getButton(INPUT_BUTTON::RIGHT) == INPUT_BUTTON_STATE::PRESSED);
+    pushPlane(InputPlane::PRESSED_ATTACK, currentInput_.getButton(INPUT_BUTTON::ATTACK) == INPUT_BUTTON_STATE::PRESSED);
+
+    pushPlane(InputPlane::HOLD_LEFT, currentInput_.getButton(INPUT_BUTTON::LEFT) == INPUT_BUTTON_STATE::HOLD);
+    pushPlane(InputPlane::HOLD_RIGHT, currentInput_.getButton(INPUT_BUTTON::RIGHT) == INPUT_BUTTON_STATE::HOLD);
+
+    pushPlane(InputPlane::DIR_UP, dir.y < 0);
+    pushPlane(InputPlane::DIR_DOWN, dir.y > 0);
+    pushPlane(InputPlane::DIR_LEFT, dir.x < 0);
+    pushPlane(InputPlane::DIR_RIGHT, dir.x > 0);
 }
 
+InputResolver::PlaneMask InputResolver::plane(InputPlane plane_) const noexcept
+{
+    return m_planes[static_cast<size_t>(plane_)];
+}
 
-bool InputResolver::checkHoldHorDir(const Orientation orientation_, unsigned int) const
+InputResolver::PlaneMask InputResolver::forwardPlane(InputPlane rightPlane_, InputPlane leftPlane_, Orientation orientation_) const noexcept
 {
-    if (m_inputQueue.getFilled() == 0)
-        return false;
+    return plane(orientation_ == Orientation::RIGHT ? rightPlane_ : leftPlane_);
+}
 
-    const int expected = (orientation_ == Orientation::RIGHT ? 1 : -1);
+InputResolver::PlaneMask InputResolver::windowMask(unsigned int extendBuffer_) noexcept
+{
+    // Bits of frames that were never added are always 0 in every plane, so there is no need to check filled count
+    const size_t lookAt = std::min(INPUT_HISTORY_LENGTH - 1, static_cast<size_t>(gamedata::global::inputBufferLength + extendBuffer_));
+    return static_cast<PlaneMask>((uint64_t{2} << lookAt) - 1);
+}
 
-    return m_inputQueue[0].m_dir.x == expected;
+bool InputResolver::checkHoldHorDir(const Orientation orientation_, unsigned int) const
+{
+    return forwardPlane(InputPlane::DIR_RIGHT, InputPlane::DIR_LEFT, orientation_) & 1;
 }
 
 bool InputResolver::checkNoHorDir(const Orientation orientation_, unsigned int) const
 {
-    if (m_inputQueue.getFilled() == 0)
-        return false;
-
-    const int expected = (orientation_ == Orientation::RIGHT ? 1 : -1);
-
-    return m_inputQueue[0].m_dir.x != expected;
+    return plane(InputPlane::PRESENT) & ~forwardPlane(InputPlane::DIR_RIGHT, InputPlane::DIR_LEFT, orientation_) & 1;
 }
 
 bool InputResolver::checkHoldUp(Orientation, unsigned int) const
 {
-    if (m_inputQueue.getFilled() == 0)
-        return false;
-
-    return m_inputQueue[0].m_dir.y < 0;
+    return plane(InputPlane::DIR_UP) & 1;
 }
 
 bool InputResolver::checkHoldUpForward(const Orientation orientation_, unsigned int) const
 {
-    if (m_inputQueue.getFilled() == 0)
-        return false;
-
-    if (m_inputQueue[0].m_dir.y >= 0)
-        return false;
-
-    if (orientation_ == Orientation::RIGHT)
-        return m_inputQueue[0].m_dir.x > 0;
-
-    return m_inputQueue[0].m_dir.x < 0;
+    return plane(InputPlane::DIR_UP) & forwardPlane(InputPlane::DIR_RIGHT, InputPlane::DIR_LEFT, orientation_) & 1;
 }
 
 bool InputResolver::checkBufferUp(Orientation, const unsigned int extendBuffer_) const
 {
-    if (m_inputQueue.getFilled() == 0)
-        return false;
-
-    size_t lookAt = std::min(m_inputQueue.getFilled() - 1, static_cast<size_t>(gamedata::global::inputBufferLength + extendBuffer_));
-    for (size_t i = 0; i <= lookAt; ++i)
-    {
-        const auto &in = m_inputQueue[i];
-        if (in.m_inputs.at(INPUT_BUTTON::UP) == INPUT_BUTTON_STATE::PRESSED && in.m_dir.y < 0)
-            return true;
-    }
-
-    return false;
+    return plane(InputPlane::PRESSED_UP) & plane(InputPlane::DIR_UP) & windowMask(extendBuffer_);
 }
 
 bool InputResolver::checkBufferUpStrict(Orientation, const unsigned int extendBuffer_) const
 {
-    if (m_inputQueue.getFilled() == 0)
-        return false;
-
-    const size_t lookAt = std::min(m_inputQueue.getFilled() - 1, static_cast<size_t>(gamedata::global::inputBufferLength + extendBuffer_));
-    for (size_t i = 0; i <= lookAt; ++i)
-    {
-        const auto &in = m_inputQueue[i];
-        if (in.m_inputs.at(INPUT_BUTTON::UP) == INPUT_BUTTON_STATE::PRESSED && in.m_dir == Vector2{0, -1})
-            return true;
-    }
-
-    return false;
+    const auto noHorDir = ~(plane(InputPlane::DIR_LEFT) | plane(InputPlane::DIR_RIGHT));
+    return plane(InputPlane::PRESSED_UP) & plane(InputPlane::DIR_UP) & noHorDir & windowMask(extendBuffer_);
 }
 
 bool InputResolver::checkBufferUpForward(const Orientation orientation_, const unsigned int extendBuffer_) const
 {
-    if (m_inputQueue.getFilled() == 0)
-        return false;
-
-    const auto expectedButton = (orientation_ == Orientation::RIGHT ? INPUT_BUTTON::RIGHT : INPUT_BUTTON::LEFT);
-    const auto expectedDir = (orientation_ == Orientation::RIGHT ? 1 : -1);
-
-    const size_t lookAt = std::min(m_inputQueue.getFilled() - 1, static_cast<size_t>(gamedata::global::inputBufferLength + extendBuffer_));
-    for (size_t i = 0; i <= lookAt; ++i)
-    {
-        const auto &in = m_inputQueue[i];
-        if (in.m_inputs.at(INPUT_BUTTON::UP) == INPUT_BUTTON_STATE::PRESSED && in.m_dir.y < 0 &&
-            in.m_inputs.at(expectedButton) == INPUT_BUTTON_STATE::HOLD && in.m_dir.x == expectedDir)
-            return true;
-    }
-
-    return false;
+    return plane(InputPlane::PRESSED_UP) & plane(InputPlane::DIR_UP) &
+        forwardPlane(InputPlane::HOLD_RIGHT, InputPlane::HOLD_LEFT, orientation_) &
+        forwardPlane(InputPlane::DIR_RIGHT, InputPlane::DIR_LEFT, orientation_) &
+        windowMask(extendBuffer_);
 }
 
 bool InputResolver::checkBufferUpForwardStrict(const Orientation orientation_, const unsigned int extendBuffer_) const
 {
-    if (m_inputQueue.getFilled() == 0)
-        return false;
-
-    const auto expectedButton = (orientation_ == Orientation::RIGHT ? INPUT_BUTTON::RIGHT : INPUT_BUTTON::LEFT);
-    const auto expectedDir = (orientation_ == Orientation::RIGHT ? 1 : -1);
-
-    bool foundUp = false;
-    bool foundForward = false;
-    bool foundDirection = false;
-
-    const size_t lookAt = std::min(m_inputQueue.getFilled() - 1, static_cast<size_t>(gamedata::global::inputBufferLength + extendBuffer_));
-    for (size_t i = 0; i <= lookAt; ++i)
-    {
-        const auto &in = m_inputQueue[i];
-        foundUp = foundUp || in.m_inputs.at(INPUT_BUTTON::UP) == INPUT_BUTTON_STATE::PRESSED;
-        foundForward = foundForward || in.m_inputs.at(expectedButton) == INPUT_BUTTON_STATE::PRESSED;
-        foundDirection = foundDirection || (in.m_dir == Vector2{expectedDir, -1});
-
-        if ((foundUp || foundForward) && foundDirection)
-            return true;
-    }
+    // Up or forward press and up-forward direction anywhere within the window, not necessarily on the same frame
+    const auto window = windowMask(extendBuffer_);
+    const auto anyPress = (plane(InputPlane::PRESSED_UP) | forwardPlane(InputPlane::PRESSED_RIGHT, InputPlane::PRESSED_LEFT, orientation_)) & window;
+    const auto direction = plane(InputPlane::DIR_UP) & forwardPlane(InputPlane::DIR_RIGHT, InputPlane::DIR_LEFT, orientation_) & window;
 
-    return false;
+    return anyPress && direction;
 }
 
 bool InputResolver::checkBufferedOrientedAttack(Orientation orientation_, const unsigned int extendBuffer_) const
 {
-    if (m_inputQueue.getFilled() == 0)
-        return false;
-
-    const auto expectedDir = (orientation_ == Orientation::RIGHT ? 1 : -1);
-
-    const size_t lookAt = std::min(m_inputQueue.getFilled() - 1, static_cast<size_t>(gamedata::global::inputBufferLength + extendBuffer_));
-    for (size_t i = 0; i <= lookAt; ++i)
-    {
-        const auto &in = m_inputQueue[i];
-        if (in.m_inputs.at(INPUT_BUTTON::ATTACK) == INPUT_BUTTON_STATE::PRESSED && (in.m_dir.x == expectedDir || in.m_dir.x == 0))
-            return true;
-    }
-
-    return false;
+    const auto backward = forwardPlane(InputPlane::DIR_LEFT, InputPlane::DIR_RIGHT, orientation_);
+    return plane(InputPlane::PRESSED_ATTACK) & ~backward & windowMask(extendBuffer_);
 }
 
 bool InputResolver::checkBufferedHoldHorDir(const Orientation orientation_, const unsigned int extendBuffer_) const
 {
-    if (m_inputQueue.getFilled() == 0)
-        return false;
-
-    const int expected = (orientation_ == Orientation::RIGHT ? 1 : -1);
-
-    const size_t lookAt = std::min(m_inputQueue.getFilled() - 1, static_cast<size_t>(gamedata::global::inputBufferLength + extendBuffer_));
-    for (size_t i = 0; i <= lookAt; ++i)
-    {
-        const auto &in = m_inputQueue[i];
-        if (in.m_dir.x == expected)
-            return true;
-    }
-
-    return false;
+    return forwardPlane(InputPlane::DIR_RIGHT, InputPlane::DIR_LEFT, orientation_) & windowMask(extendBuffer_);
 }
 
 bool InputResolver::checkTapExceptBackwards(const Orientation orientation_, const unsigned int extendBuffer_) const
 {
-    if (m_inputQueue.getFilled() == 0)
-        return false;
+    // A press counts if the matching direction was held on the same or any newer frame within the window
+    const auto window = windowMask(extendBuffer_);
 
-    const auto expectedButton = (orientation_ == Orientation::RIGHT ? INPUT_BUTTON::RIGHT : INPUT_BUTTON::LEFT);
-    const int expected = (orientation_ == Orientation::RIGHT ? 1 : -1);
+    const auto horTap = forwardPlane(InputPlane::PRESSED_RIGHT, InputPlane::PRESSED_LEFT, orientation_) &
+        fillOlder(forwardPlane(InputPlane::DIR_RIGHT, InputPlane::DIR_LEFT, orientation_) & window);
+    const auto upTap = plane(InputPlane::PRESSED_UP) & fillOlder(plane(InputPlane::DIR_UP) & window);
+    const auto downTap = plane(InputPlane::PRESSED_DOWN) & fillOlder(plane(InputPlane::DIR_DOWN) & window);
 
-    bool vUpDirDiscovered = false;
-    bool vDownDirDiscovered = false;
-    bool horDirDiscovered = false;
-
-    const size_t lookAt = std::min(m_inputQueue.getFilled() - 1, static_cast<size_t>(gamedata::global::inputBufferLength + extendBuffer_));
-    for (size_t i = 0; i <= lookAt; ++i)
-    {
-        const auto &in = m_inputQueue[i];
-        vUpDirDiscovered = vUpDirDiscovered || in.m_dir.y < 0;
-        vDownDirDiscovered = vDownDirDiscovered || in.m_dir.y > 0;
-        horDirDiscovered = horDirDiscovered || in.m_dir.x == expected;
-
-        if (in.m_inputs.at(expectedButton) == INPUT_BUTTON_STATE::PRESSED && horDirDiscovered ||
-            in.m_inputs.at(INPUT_BUTTON::UP) == INPUT_BUTTON_STATE::PRESSED && vUpDirDiscovered ||
-            in.m_inputs.at(INPUT_BUTTON::DOWN) == INPUT_BUTTON_STATE::PRESSED && vDownDirDiscovered)
-            return true;
-    }
-
-    return false;
+    return (horTap | upTap | downTap) & window;
 }
 
 
 Vector2<int> InputResolver::getCurrentInputDir() const
 {
     if (m_inputQueue.getFilled() > 0)
-        return m_inputQueue[0].m_dir;
+        return m_inputQueue[0].getDir();
 
     return {0, 0};
 }
 
 bool InputResolver::checkInput(InputMotions motion_, Orientation orientation_, unsigned int extendBuffer_) const
 {
-    return (this->*m_inputComparators.at(motion_))(orientation_, extendBuffer_);
+    const auto idx = static_cast<size_t>(motion_);
+    if (idx >= m_inputComparators.size() || !m_inputComparators[idx])
+        throw std::runtime_error(std::format("Input motion {} is not supported", serialize(motion_)));
+
+    return (this->*m_inputComparators[idx])(orientation_, extendBuffer_);
 }
 
 bool InputResolver::isInputActive(const INPUT_BUTTON button_) const
@@ -1,6 +1,6 @@
 #pragma once
 #include "InputState.h"
-#include <unordered_map>
+#include <array>
 
 enum class InputMotions : uint8_t
 {
@@ -51,11 +51,15 @@ SERIALIZE_ENUM(InputMotions, {
     ENUM_AUTO(InputMotions, BUFFERED_ORIENTED_ATTACK)
 })
 
+/*
+    Besides the raw history, every frame is split into a set of per-frame predicates ("planes"),
+    each plane is a shift register where bit i is the predicate value i frames ago.
+    Motion checks are bitwise expressions over the planes masked by the buffer window,
+    so there is no per-frame iteration when checking input
+*/
 class InputResolver
 {
 public:
-    InputResolver();
-
     void addFrame(const InputState &currentInput_);
 
     Vector2<int> getCurrentInputDir() const;
@@ -83,8 +87,40 @@ private:
 
     bool checkBufferedOrientedAttack(Orientation orientation_, unsigned int extendBuffer_) const;
 
+    enum class InputPlane : uint8_t
+    {
+        PRESENT,
+
+        PRESSED_UP,
+        PRESSED_DOWN,
+        PRESSED_LEFT,
+        PRESSED_RIGHT,
+        PRESSED_ATTACK,
+
+        HOLD_LEFT,
+        HOLD_RIGHT,
+
+        DIR_UP,
+        DIR_DOWN,
+        DIR_LEFT,
+        DIR_RIGHT,
+
+        COUNT
+    };
+
+    using PlaneMask = uint32_t;
+    static_assert(INPUT_HISTORY_LENGTH <= sizeof(PlaneMask) * 8, "Input planes should be able to fit the entire history");
+
+    PlaneMask plane(InputPlane plane_) const noexcept;
+    PlaneMask forwardPlane(InputPlane rightPlane_, InputPlane leftPlane_, Orientation orientation_) const noexcept;
+    static PlaneMask windowMask(unsigned int extendBuffer_) noexcept;
+
     using InputCheck = bool (InputResolver::*)(Orientation, unsigned int) const;
+    static constexpr size_t MOTIONS_COUNT = static_cast<size_t>(InputMotions::BUFFERED_ORIENTED_ATTACK) + 1;
+
+    // Indexed by InputMotions, nullptr for motions without implementation
+    static const std::array<InputCheck, MOTIONS_COUNT> m_inputComparators;
 
     InputQueue m_inputQueue;
-    std::unordered_map<InputMotions, InputCheck> m_inputComparators;
+    std::array<PlaneMask, static_cast<size_t>(InputPlane::COUNT)> m_planes = {};
 };
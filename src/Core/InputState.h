@@ -1,7 +1,7 @@
 #pragma once
 #include "FixedQueue.hpp"
 #include "Vector2.hpp"
-#include <map>
+#include <cstdint>
 
 enum class INPUT_BUTTON : uint8_t {UP, DOWN, LEFT, RIGHT, ATTACK};
 enum class INPUT_BUTTON_STATE : uint8_t {PRESSED, HOLD, RELEASED, OFF};
@@ -21,31 +21,60 @@ SERIALIZE_ENUM(INPUT_BUTTON_STATE, {
     ENUM_INIT(INPUT_BUTTON_STATE, OFF, "┬"),
 })
 
+/*
+    Button states packed into a single word, 2 bits per button in INPUT_BUTTON order
+    High bit of each pair is set for RELEASED and OFF, so "active" is just a cleared high bit
+    PRESSED => HOLD and RELEASED => OFF both only set the low bit, so next frame state is a single OR
+    Direction is derived from the buttons and is not stored
+*/
 struct InputState
 {
-    std::map<INPUT_BUTTON, INPUT_BUTTON_STATE> m_inputs = {
-        {INPUT_BUTTON::UP, INPUT_BUTTON_STATE::OFF},
-        {INPUT_BUTTON::DOWN, INPUT_BUTTON_STATE::OFF},
-        {INPUT_BUTTON::LEFT, INPUT_BUTTON_STATE::OFF},
-        {INPUT_BUTTON::RIGHT, INPUT_BUTTON_STATE::OFF},
-        {INPUT_BUTTON::ATTACK, INPUT_BUTTON_STATE::OFF}
-    };
-    Vector2<int> m_dir{0, 0};
+    static constexpr uint16_t BUTTON_MASK = 0b11;
+    static constexpr uint16_t ALL_OFF = 0b11'11'11'11'11;
+    static constexpr uint16_t LOW_BITS = 0b01'01'01'01'01;
 
-    bool isInputActive(const INPUT_BUTTON &btn_) const;
+    uint16_t m_inputs = ALL_OFF;
 
-    void setDirFromButtons();
+    static constexpr uint16_t shiftOf(INPUT_BUTTON btn_) noexcept
+    {
+        return static_cast<uint16_t>(btn_) * 2;
+    }
+
+    constexpr INPUT_BUTTON_STATE getButton(INPUT_BUTTON btn_) const noexcept
+    {
+        return static_cast<INPUT_BUTTON_STATE>((m_inputs >> shiftOf(btn_)) & BUTTON_MASK);
+    }
+
+    constexpr void setButton(INPUT_BUTTON btn_, INPUT_BUTTON_STATE state_) noexcept
+    {
+        m_inputs = static_cast<uint16_t>((m_inputs & ~(BUTTON_MASK << shiftOf(btn_))) | (static_cast<uint16_t>(state_) << shiftOf(btn_)));
+    }
 
-    InputState getNextFrameState() const;
+    constexpr bool isInputActive(INPUT_BUTTON btn_) const noexcept
+    {
+        return ((m_inputs >> (shiftOf(btn_) + 1)) & 1) == 0;
+    }
+
+    constexpr Vector2<int> getDir() const noexcept
+    {
+        return {
+            (isInputActive(INPUT_BUTTON::RIGHT) ? 1 : 0) - (isInputActive(INPUT_BUTTON::LEFT) ? 1 : 0),
+            (isInputActive(INPUT_BUTTON::DOWN) ? 1 : 0) - (isInputActive(INPUT_BUTTON::UP) ? 1 : 0)
+        };
+    }
 
-    InputState() = default;
-    InputState(const InputState &inputState_);
-    InputState &operator=(const InputState &rhs_);
-    InputState(InputState &&inputState_) noexcept;
-    InputState &operator=(InputState &&rhs_) noexcept;
+    constexpr InputState getNextFrameState() const noexcept
+    {
+        return {static_cast<uint16_t>(m_inputs | LOW_BITS)};
+    }
 };
 
-using InputQueue = FixedQueue<InputState, 30>;
+static_assert(static_cast<uint16_t>(INPUT_BUTTON_STATE::PRESSED) == 0b00 && static_cast<uint16_t>(INPUT_BUTTON_STATE::HOLD) == 0b01 &&
+              static_cast<uint16_t>(INPUT_BUTTON_STATE::RELEASED) == 0b10 && static_cast<uint16_t>(INPUT_BUTTON_STATE::OFF) == 0b11,
+              "InputState packing relies on the order of INPUT_BUTTON_STATE");
+
+constexpr size_t INPUT_HISTORY_LENGTH = 30;
+using InputQueue = FixedQueue<InputState, INPUT_HISTORY_LENGTH>;
 
 template <> 
 struct std::formatter<InputState> : std::formatter<std::string_view> 
@@ -53,12 +82,12 @@ struct std::formatter<InputState> : std::formatter<std::string_view>
     auto format(const InputState &data_, format_context &ctx_) const 
     {
         return formatter<std::string_view>::format(
-            std::format("{} {}:{}, {}:{}, {}:{}, {}:{}, {}:{}", data_.m_dir, 
-                serialize(INPUT_BUTTON::UP), serialize(data_.m_inputs.at(INPUT_BUTTON::UP)),
-                serialize(INPUT_BUTTON::DOWN), serialize(data_.m_inputs.at(INPUT_BUTTON::DOWN)),
-                serialize(INPUT_BUTTON::LEFT), serialize(data_.m_inputs.at(INPUT_BUTTON::LEFT)),
-                serialize(INPUT_BUTTON::RIGHT), serialize(data_.m_inputs.at(INPUT_BUTTON::RIGHT)),
-                serialize(INPUT_BUTTON::ATTACK), serialize(data_.m_inputs.at(INPUT_BUTTON::UP))), 
+            std::format("{} {}:{}, {}:{}, {}:{}, {}:{}, {}:{}", data_.getDir(), 
+                serialize(INPUT_BUTTON::UP), serialize(data_.getButton(INPUT_BUTTON::UP)),
+                serialize(INPUT_BUTTON::DOWN), serialize(data_.getButton(INPUT_BUTTON::DOWN)),
+                serialize(INPUT_BUTTON::LEFT), serialize(data_.getButton(INPUT_BUTTON::LEFT)),
+                serialize(INPUT_BUTTON::RIGHT), serialize(data_.getButton(INPUT_BUTTON::RIGHT)),
+                serialize(INPUT_BUTTON::ATTACK), serialize(data_.getButton(INPUT_BUTTON::ATTACK))), 
             ctx_);
     }
 };
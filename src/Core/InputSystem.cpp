@@ -3,6 +3,8 @@
 #include "JsonUtils.hpp"
 #include "FilesystemUtils.h"
 #include "Logger.hpp"  // IWYU pragma: keep
+#include <algorithm>
+#include <bit>
 #include <iostream>
 #include <filesystem>
 #include <fstream>
@@ -26,6 +28,9 @@ InputSystem::InputSystem() :
         importMappingEnsureUnique(m_configPath);
     }
 
+    m_gameplayBindings.compile();
+    m_hudBindings.compile();
+
     initiateControllers();
 }
 
@@ -33,99 +38,101 @@ void InputSystem::handleInput()
 {
     SDL_Event e;
     while (SDL_PollEvent(&e))
-    {
-        switch (e.type)
-        {
-        case (SDL_EVENT_QUIT):
-            send(GAMEPLAY_EVENTS::QUIT, 1);
-            break;
+        handleEvent(e);
+}
 
-        case (SDL_EVENT_KEY_DOWN):
-        {
-            if (e.key.repeat)
-                break;
+void InputSystem::handleEvent(const SDL_Event &e_)
+{
+    switch (e_.type)
+    {
+    case (SDL_EVENT_QUIT):
+        send(GAMEPLAY_EVENTS::QUIT, 1);
+        break;
 
-            resolveBinding(m_gameplayBindings.m_keyboardBindings, e.key.key, 1);
-            resolveBinding(m_hudBindings.m_keyboardBindings, e.key.key, 1);
-            
-        }
+    case (SDL_EVENT_KEY_DOWN):
+    {
+        if (e_.key.repeat)
             break;
 
-        case (SDL_EVENT_KEY_UP):
-        {
-            resolveBinding(m_gameplayBindings.m_keyboardBindings, e.key.key, -1);
-            resolveBinding(m_hudBindings.m_keyboardBindings, e.key.key, -1);
-        }
+        sendIfBound(m_gameplayBindings.resolveKey(e_.key.key), 1);
+        sendIfBound(m_hudBindings.resolveKey(e_.key.key), 1);
+        
+    }
         break;
 
-        case (SDL_EVENT_GAMEPAD_ADDED):
-            m_controllers[e.cdevice.which].m_controller = SDL_OpenGamepad(e.cdevice.which);
-            LOG_INFO("Discovered new controller at {}: {}", e.cdevice.which, SDL_GetGamepadName(m_controllers[e.cdevice.which].m_controller));
-        break;
+    case (SDL_EVENT_KEY_UP):
+    {
+        sendIfBound(m_gameplayBindings.resolveKey(e_.key.key), -1);
+        sendIfBound(m_hudBindings.resolveKey(e_.key.key), -1);
+    }
+    break;
 
-        case (SDL_EVENT_GAMEPAD_REMOVED):
-            LOG_INFO("Removing controller at {}", e.cdevice.which);
-            SDL_CloseGamepad(m_controllers[e.cdevice.which].m_controller);
-            m_controllers.erase(e.cdevice.which);
-        break;
+    case (SDL_EVENT_GAMEPAD_ADDED):
+        m_controllers[e_.cdevice.which].m_controller = SDL_OpenGamepad(e_.cdevice.which);
+        LOG_INFO("Discovered new controller at {}: {}", e_.cdevice.which, SDL_GetGamepadName(m_controllers[e_.cdevice.which].m_controller));
+    break;
 
-        case (SDL_EVENT_GAMEPAD_BUTTON_DOWN):
-        {
-            //std::cout << "Controller pressed " << gamepadButtonNames.at(e.gbutton.button) << std::endl;
+    case (SDL_EVENT_GAMEPAD_REMOVED):
+        LOG_INFO("Removing controller at {}", e_.cdevice.which);
+        SDL_CloseGamepad(m_controllers[e_.cdevice.which].m_controller);
+        m_controllers.erase(e_.cdevice.which);
+    break;
 
-            resolveBinding(m_gameplayBindings.m_gamepadBindings, e.gbutton.button, 1);
-            resolveBinding(m_hudBindings.m_gamepadBindings, e.gbutton.button, 1);
-        }
-        break;
+    case (SDL_EVENT_GAMEPAD_BUTTON_DOWN):
+    {
+        //std::cout << "Controller pressed " << gamepadButtonNames.at(e_.gbutton.button) << std::endl;
+
+        sendIfBound(m_gameplayBindings.resolveButton(e_.gbutton.button), 1);
+        sendIfBound(m_hudBindings.resolveButton(e_.gbutton.button), 1);
+    }
+    break;
+
+    case (SDL_EVENT_GAMEPAD_BUTTON_UP):
+    {
+        //std::cout << "Controller released " << gamepadButtonNames.at(e_.gbutton.button) << std::endl;
 
-        case (SDL_EVENT_GAMEPAD_BUTTON_UP):
+        sendIfBound(m_gameplayBindings.resolveButton(e_.gbutton.button), -1);
+        sendIfBound(m_hudBindings.resolveButton(e_.gbutton.button), -1);
+    }
+    break;
+
+    case (SDL_EVENT_GAMEPAD_AXIS_MOTION):
+    {
+        const Sint16 resolvedValue = abs(e_.gaxis.value) > m_stickDeadzone ? e_.gaxis.value : 0;
+
+        if (e_.gaxis.axis < m_lastAxisValue.size())
         {
-            //std::cout << "Controller released " << gamepadButtonNames.at(e.gbutton.button) << std::endl;
+            if (m_lastAxisValue[e_.gaxis.axis] == resolvedValue)
+                break;
 
-            resolveBinding(m_gameplayBindings.m_gamepadBindings, e.gbutton.button, -1);
-            resolveBinding(m_hudBindings.m_gamepadBindings, e.gbutton.button, -1);
+            m_lastAxisValue[e_.gaxis.axis] = resolvedValue;
         }
-        break;
 
-        case (SDL_EVENT_GAMEPAD_AXIS_MOTION):
+        float posValue = 0, negValue = 0;
+        if (resolvedValue >= 0)
         {
-            const Sint16 resolvedValue = abs(e.gaxis.value) > m_stickDeadzone ? e.gaxis.value : 0;
-
-            auto lastValueRes = m_lastAxisValue.find(e.gaxis.axis);
-            if (lastValueRes != m_lastAxisValue.end())
-            {
-                if (lastValueRes->second == resolvedValue)
-                    break;
-
-                lastValueRes->second = resolvedValue;
-            }
-
-            float posValue = 0, negValue = 0;
-            if (resolvedValue >= 0)
-            {
-                posValue = static_cast<float>(resolvedValue) / 32767.0f;
-                negValue = 0;
-            }
-            else
-            {
-                negValue = static_cast<float>(resolvedValue) / -32768.0f;
-                posValue = 0;
-            }
-
-            resolveBinding(m_gameplayBindings.m_gamepadPositiveAxisBindings, e.gaxis.axis, posValue);
-            resolveBinding(m_gameplayBindings.m_gamepadNegativeAxisBindings, e.gaxis.axis, negValue);
-            resolveBinding(m_hudBindings.m_gamepadPositiveAxisBindings, e.gaxis.axis, posValue);
-            resolveBinding(m_hudBindings.m_gamepadNegativeAxisBindings, e.gaxis.axis, negValue);
-
-            //std::cout << "Controller axis motion " << gamepadAxisNames.at(e.gaxis.axis) << " : " << int(e.gaxis.value) << std::endl;
+            posValue = static_cast<float>(resolvedValue) / 32767.0f;
+            negValue = 0;
         }
-        break;
-
-        default:
-            //std::cout << "Unknown event " << int(e.type) << std::endl;
-        break;
-        
+        else
+        {
+            negValue = static_cast<float>(resolvedValue) / -32768.0f;
+            posValue = 0;
         }
+
+        sendIfBound(m_gameplayBindings.resolvePositiveAxis(e_.gaxis.axis), posValue);
+        sendIfBound(m_gameplayBindings.resolveNegativeAxis(e_.gaxis.axis), negValue);
+        sendIfBound(m_hudBindings.resolvePositiveAxis(e_.gaxis.axis), posValue);
+        sendIfBound(m_hudBindings.resolveNegativeAxis(e_.gaxis.axis), negValue);
+
+        //std::cout << "Controller axis motion " << gamepadAxisNames.at(e_.gaxis.axis) << " : " << int(e_.gaxis.value) << std::endl;
+    }
+    break;
+
+    default:
+        //std::cout << "Unknown event " << int(e_.type) << std::endl;
+    break;
+    
     }
 }
 
@@ -140,17 +147,7 @@ void InputSystem::subscribe(GAMEPLAY_EVENTS ev_, Subscriber sub_)
 //Automatically called when InputReactor is destroyed
 void InputSystem::unsubscribe(GAMEPLAY_EVENTS ev_, Subscriber sub_)
 {
-    // If this operation was more frequent, unordered_set would be better, but iteration is more important
-    std::vector<Subscriber>& v = m_gameplaySubscribers[(int)ev_];
-
-    size_t i = 0;
-    while (i < v.size())
-    {
-        if (v[i] == sub_)
-            v.erase(v.begin() + static_cast<int64_t>(i));
-        else
-            i++;
-    }
+    removeSubscriber(m_gameplaySubscribers[(int)ev_], sub_);
 }
 
 void InputSystem::subscribe(HUD_EVENTS ev_, Subscriber sub_)
@@ -162,16 +159,40 @@ void InputSystem::subscribe(HUD_EVENTS ev_, Subscriber sub_)
 
 void InputSystem::unsubscribe(HUD_EVENTS ev_, Subscriber sub_)
 {
-    std::vector<Subscriber>& v = m_hudSubscribers[(int)ev_];
+    removeSubscriber(m_hudSubscribers[(int)ev_], sub_);
+}
+
+void InputSystem::removeSubscriber(std::vector<Subscriber> &subs_, Subscriber sub_)
+{
+    auto it = std::find(subs_.begin(), subs_.end(), sub_);
+    if (it == subs_.end())
+        return;
 
-    size_t i = 0;
-    while (i < v.size())
+    // Swapping while an event is sent would move a subscriber that wasn't notified yet behind the current index
+    if (m_dispatchDepth > 0)
     {
-        if (v[i] == sub_)
-            v.erase(v.begin() + static_cast<int64_t>(i));
-        else
-            i++;
+        *it = nullptr;
+        m_hasRemovedSubscribers = true;
+        return;
     }
+
+    *it = subs_.back();
+    subs_.pop_back();
+}
+
+void InputSystem::compactSubscribers()
+{
+    const auto compact = [](std::vector<Subscriber> &subs_) {
+        subs_.erase(std::remove(subs_.begin(), subs_.end(), nullptr), subs_.end());
+    };
+
+    for (auto &subs : m_gameplaySubscribers)
+        compact(subs);
+
+    for (auto &subs : m_hudSubscribers)
+        compact(subs);
+
+    m_hasRemovedSubscribers = false;
 }
 
 void InputSystem::initiateControllers()
@@ -198,26 +219,41 @@ void InputSystem::initiateControllers()
     SDL_free(pads);
 }
 
-void InputSystem::send(GAMEPLAY_EVENTS ev_, float val_)
+/*
+    Indices instead of iterators since reactors can subscribe and unsubscribe while handling events
+    Removed subscribers are only nulled during dispatch and compacted once the outermost dispatch is over
+*/
+template<typename EventT>
+void InputSystem::dispatch(const std::vector<Subscriber> &subs_, EventT ev_, float val_)
 {
-    for (auto& sub : m_gameplaySubscribers[(int)ev_])
+    m_dispatchDepth++;
+    for (size_t i = 0; i < subs_.size(); ++i)
     {
-        if (sub->isInputEnabled())
+        if (subs_[i] && subs_[i]->isInputEnabled())
         {
-            sub->receiveEvents(ev_, val_);
+            subs_[i]->receiveEvents(ev_, val_);
         }
     }
+    m_dispatchDepth--;
+
+    if (m_dispatchDepth == 0 && m_hasRemovedSubscribers)
+        compactSubscribers();
+}
+
+void InputSystem::send(GAMEPLAY_EVENTS ev_, float val_)
+{
+    if (!Application::instance().m_inputSession.isEventAllowed(ev_))
+        return;
+
+    dispatch(m_gameplaySubscribers[(int)ev_], ev_, val_);
 }
 
 void InputSystem::send(HUD_EVENTS ev_, float val_)
 {
-    for (auto& sub : m_hudSubscribers[(int)ev_])
-    {
-        if (sub->isInputEnabled())
-        {
-            sub->receiveEvents(ev_, val_);
-        }
-    }
+    if (!Application::instance().m_inputSession.isEventAllowed(ev_))
+        return;
+
+    dispatch(m_hudSubscribers[(int)ev_], ev_, val_);
 }
 
 void InputSystem::setupDefaultMapping()
@@ -345,14 +381,75 @@ void InputSystem::importMappingEnsureUnique(const std::string &fileName_)
     }
 }
 
-template <typename InputT, typename ButtonT, typename EventT>
-void InputSystem::resolveBinding(const std::map<InputT, EventT> &bindings_, const ButtonT &input_, float value_)
+template<typename EventT>
+void InputSystem::sendIfBound(EventT ev_, float value_)
+{
+    if (ev_ != EventT::NONE)
+        send(ev_, value_);
+}
+
+template<typename EventT>
+void EventBinding<EventT>::compile()
 {
-    auto res = bindings_.find(InputT(input_));
-    if (res != bindings_.end())
+    m_keyboardLookup.fill(EventT::NONE);
+    m_gamepadLookup.fill(EventT::NONE);
+    m_positiveAxisLookup.fill(EventT::NONE);
+    m_negativeAxisLookup.fill(EventT::NONE);
+
+    for (const auto &[key, ev] : m_keyboardBindings)
     {
-        send(res->second, value_);
+        const auto idx = keycodeToLookupIndex(key);
+        if (idx < m_keyboardLookup.size())
+            m_keyboardLookup[idx] = ev;
     }
+
+    for (const auto &[button, ev] : m_gamepadBindings)
+    {
+        if (button >= 0 && button < SDL_GAMEPAD_BUTTON_COUNT)
+            m_gamepadLookup[button] = ev;
+    }
+
+    for (const auto &[axis, ev] : m_gamepadPositiveAxisBindings)
+    {
+        if (axis >= 0 && axis < SDL_GAMEPAD_AXIS_COUNT)
+            m_positiveAxisLookup[axis] = ev;
+    }
+
+    for (const auto &[axis, ev] : m_gamepadNegativeAxisBindings)
+    {
+        if (axis >= 0 && axis < SDL_GAMEPAD_AXIS_COUNT)
+            m_negativeAxisLookup[axis] = ev;
+    }
+}
+
+template<typename EventT>
+EventT EventBinding<EventT>::resolveKey(SDL_Keycode key_) const
+{
+    const auto idx = keycodeToLookupIndex(key_);
+    if (idx < m_keyboardLookup.size())
+        return m_keyboardLookup[idx];
+
+    // Non-ASCII characters from exotic layouts
+    auto res = m_keyboardBindings.find(key_);
+    return (res != m_keyboardBindings.end() ? res->second : EventT::NONE);
+}
+
+template<typename EventT>
+EventT EventBinding<EventT>::resolveButton(Uint8 button_) const
+{
+    return (button_ < m_gamepadLookup.size() ? m_gamepadLookup[button_] : EventT::NONE);
+}
+
+template<typename EventT>
+EventT EventBinding<EventT>::resolvePositiveAxis(Uint8 axis_) const
+{
+    return (axis_ < m_positiveAxisLookup.size() ? m_positiveAxisLookup[axis_] : EventT::NONE);
+}
+
+template<typename EventT>
+EventT EventBinding<EventT>::resolveNegativeAxis(Uint8 axis_) const
+{
+    return (axis_ < m_negativeAxisLookup.size() ? m_negativeAxisLookup[axis_] : EventT::NONE);
 }
 
 InputReactor::InputReactor() :
@@ -360,15 +457,26 @@ InputReactor::InputReactor() :
 {
 }
 
+InputReactor::InputReactor(InputSystem &input_) :
+    m_input(input_)
+{
+}
+
 InputReactor::InputReactor(const InputReactor &rhs_) :
     m_input(rhs_.m_input),
     m_inputEnabled(rhs_.m_inputEnabled)
 {
-    for (const auto &el : rhs_.m_gameplaySubscriptions)
-        subscribe(el);
+    for (size_t i = 0; i < (size_t)GAMEPLAY_EVENTS::NONE; ++i)
+    {
+        if (rhs_.m_gameplaySubscriptions & (1u << i))
+            subscribe(static_cast<GAMEPLAY_EVENTS>(i));
+    }
 
-    for (const auto &el : rhs_.m_hudSubscriptions)
-        subscribe(el);
+    for (size_t i = 0; i < (size_t)HUD_EVENTS::NONE; ++i)
+    {
+        if (rhs_.m_hudSubscriptions & (1u << i))
+            subscribe(static_cast<HUD_EVENTS>(i));
+    }
 }
 
 InputReactor::InputReactor(InputReactor &&rhs_) noexcept :
@@ -409,49 +517,53 @@ InputReactor::~InputReactor()
 
 void InputReactor::subscribe(GAMEPLAY_EVENTS ev_)
 {
-    if (m_gameplaySubscriptions.contains(ev_))
+    const uint32_t bit = 1u << (uint32_t)ev_;
+    if (m_gameplaySubscriptions & bit)
         return;
     
     m_input.subscribe(ev_, this);
-    m_gameplaySubscriptions.insert(ev_);
+    m_gameplaySubscriptions |= bit;
 }
 
 void InputReactor::subscribe(HUD_EVENTS ev_)
 {
-    if (m_hudSubscriptions.contains(ev_))
+    const uint32_t bit = 1u << (uint32_t)ev_;
+    if (m_hudSubscriptions & bit)
         return;
     
     m_input.subscribe(ev_, this);
-    m_hudSubscriptions.insert(ev_);
+    m_hudSubscriptions |= bit;
 }
 
 void InputReactor::unsubscribe(GAMEPLAY_EVENTS ev_)
 {
-    if (!m_gameplaySubscriptions.contains(ev_))
+    const uint32_t bit = 1u << (uint32_t)ev_;
+    if (!(m_gameplaySubscriptions & bit))
         return;
     
     m_input.unsubscribe(ev_, this);
-    m_gameplaySubscriptions.erase(ev_);
+    m_gameplaySubscriptions &= ~bit;
 }
 
 void InputReactor::unsubscribe(HUD_EVENTS ev_)
 {
-    if (!m_hudSubscriptions.contains(ev_))
+    const uint32_t bit = 1u << (uint32_t)ev_;
+    if (!(m_hudSubscriptions & bit))
         return;
     
     m_input.unsubscribe(ev_, this);
-    m_hudSubscriptions.erase(ev_);
+    m_hudSubscriptions &= ~bit;
 }
 
 void InputReactor::unsubscribeFromAll()
 {
-    while (!m_gameplaySubscriptions.empty())
+    while (m_gameplaySubscriptions)
     {
-        unsubscribe(*m_gameplaySubscriptions.begin());
+        unsubscribe(static_cast<GAMEPLAY_EVENTS>(std::countr_zero(m_gameplaySubscriptions)));
     }
 
-    while (!m_hudSubscriptions.empty())
+    while (m_hudSubscriptions)
     {
-        unsubscribe(*m_hudSubscriptions.begin());
+        unsubscribe(static_cast<HUD_EVENTS>(std::countr_zero(m_hudSubscriptions)));
     }
 }
@@ -1,9 +1,9 @@
 #pragma once
 #include <SDL3/SDL.h>
 #include "StaticMapping.hpp"
+#include <array>
 #include <map>
 #include <vector>
-#include <set>
 
 //List of possible gameplay events
 //Anything that is inherited from InputReactor can subscribe to them
@@ -366,6 +366,24 @@ SERIALIZE_ENUM(SDL_Keycode, {
     ENUM_INIT_NODOTS(SDLK_RHYPER, "RHYPER")*/
 })
 
+// Printable keys are their own codepoints, the rest are scancodes with SDLK_SCANCODE_MASK
+inline constexpr size_t KEYCODE_LOOKUP_SIZE = 128 + SDL_SCANCODE_COUNT;
+
+constexpr size_t keycodeToLookupIndex(SDL_Keycode key_) noexcept
+{
+    if (key_ < 128)
+        return key_;
+
+    if ((key_ & SDLK_SCANCODE_MASK) && (key_ & ~SDLK_SCANCODE_MASK) < SDL_SCANCODE_COUNT)
+        return 128 + (key_ & ~SDLK_SCANCODE_MASK);
+
+    return KEYCODE_LOOKUP_SIZE;
+}
+
+/*
+    Maps are used for config import and export
+    compile() turns them into dense tables indexed by keycode / button / axis, unbound inputs resolve into EventT::NONE
+*/
 template<typename EventT>
 struct EventBinding
 {
@@ -373,6 +391,19 @@ struct EventBinding
     std::map<SDL_GamepadButton, EventT> m_gamepadBindings;
     std::map<SDL_GamepadAxis, EventT> m_gamepadPositiveAxisBindings;
     std::map<SDL_GamepadAxis, EventT> m_gamepadNegativeAxisBindings;
+
+    void compile();
+
+    EventT resolveKey(SDL_Keycode key_) const;
+    EventT resolveButton(Uint8 button_) const;
+    EventT resolvePositiveAxis(Uint8 axis_) const;
+    EventT resolveNegativeAxis(Uint8 axis_) const;
+
+private:
+    std::array<EventT, KEYCODE_LOOKUP_SIZE> m_keyboardLookup;
+    std::array<EventT, SDL_GAMEPAD_BUTTON_COUNT> m_gamepadLookup;
+    std::array<EventT, SDL_GAMEPAD_AXIS_COUNT> m_positiveAxisLookup;
+    std::array<EventT, SDL_GAMEPAD_AXIS_COUNT> m_negativeAxisLookup;
 };
 
 class InputReactor;
@@ -393,6 +424,7 @@ class InputSystem
 public:
     InputSystem();
     void handleInput();
+    void handleEvent(const SDL_Event &e_);
     void subscribe(GAMEPLAY_EVENTS ev_, Subscriber sub_);
     void unsubscribe(GAMEPLAY_EVENTS ev_, Subscriber sub_);
     void subscribe(HUD_EVENTS ev_, Subscriber sub_);
@@ -403,12 +435,22 @@ public:
 private:
     void send(GAMEPLAY_EVENTS ev_, float val_);
     void send(HUD_EVENTS ev_, float val_);
-    std::vector<Subscriber> m_gameplaySubscribers[(int)GAMEPLAY_EVENTS::NONE];
-    std::vector<Subscriber> m_hudSubscribers[(int)HUD_EVENTS::NONE];
+
+    template<typename EventT>
+    void dispatch(const std::vector<Subscriber> &subs_, EventT ev_, float val_);
+    void removeSubscriber(std::vector<Subscriber> &subs_, Subscriber sub_);
+    void compactSubscribers();
+
+    // Each reactor is subscribed to each event at most once, order of subscribers is not preserved on removal
+    // Slots can be nullptr while an event is being sent
+    std::array<std::vector<Subscriber>, (size_t)GAMEPLAY_EVENTS::NONE> m_gameplaySubscribers;
+    std::array<std::vector<Subscriber>, (size_t)HUD_EVENTS::NONE> m_hudSubscribers;
+    uint32_t m_dispatchDepth = 0;
+    bool m_hasRemovedSubscribers = false;
     void initiateControllers();
 
-    template<typename InputT, typename ButtonT, typename EventT>
-    void resolveBinding(const std::map<InputT, EventT> &bindings_, const ButtonT &input_, float value_);
+    template<typename EventT>
+    void sendIfBound(EventT ev_, float value_);
 
     void setupDefaultMapping();
     void exportMappingAs(const std::string &fileName_);
@@ -419,12 +461,7 @@ private:
     EventBinding<GAMEPLAY_EVENTS> m_gameplayBindings;
     EventBinding<HUD_EVENTS> m_hudBindings;
 
-    std::map<Uint8, Sint16> m_lastAxisValue = {
-        {SDL_GAMEPAD_AXIS_LEFTX, Sint16(0)},
-        {SDL_GAMEPAD_AXIS_LEFTY, Sint16(0)},
-        {SDL_GAMEPAD_AXIS_RIGHTX, Sint16(0)},
-        {SDL_GAMEPAD_AXIS_RIGHTY, Sint16(0)}
-    };
+    std::array<Sint16, SDL_GAMEPAD_AXIS_COUNT> m_lastAxisValue = {};
 
     std::map<size_t, ControllerDescription> m_controllers;
 
@@ -438,6 +475,7 @@ class InputReactor
 {
 public:
     InputReactor();
+    explicit InputReactor(InputSystem &input_);
     InputReactor(const InputReactor&);
     InputReactor(InputReactor&&) noexcept;
     InputReactor &operator=(const InputReactor&) = delete;
@@ -463,7 +501,9 @@ protected:
     InputSystem &m_input;
     bool m_inputEnabled = false;
 
-    //All GAMEPLAY_EVENTS reactor is subscribed at
-    std::set<GAMEPLAY_EVENTS> m_gameplaySubscriptions;
-    std::set<HUD_EVENTS> m_hudSubscriptions;
+    //All GAMEPLAY_EVENTS and HUD_EVENTS reactor is subscribed at, one bit per event
+    uint32_t m_gameplaySubscriptions = 0;
+    uint32_t m_hudSubscriptions = 0;
+
+    static_assert((size_t)GAMEPLAY_EVENTS::NONE <= 32 && (size_t)HUD_EVENTS::NONE <= 32, "Subscription masks are too small");
 };
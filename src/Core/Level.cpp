@@ -1,5 +1,10 @@
 #include "Level.h"
+#include "Application.h"
+#include "FilesystemUtils.h"
+#include "Logger.hpp"  // IWYU pragma: keep
 #include "Profile.h"
+#include <algorithm>
+#include <exception>
 #include <optional>
 
 Level::Level(std::string levelName_, FPSUtility &fpsUtility_, const Vector2<int> &size_) :
@@ -21,21 +26,42 @@ void Level::enter()
     m_state = STATE::RUNNING;
     m_returnVal.nextLvl.reset();
     setInputEnabled();
+    Application::instance().m_inputSession.beginLevel(m_levelName);
+    Application::instance().m_frameTelemetry.beginLevel(m_levelName, m_fpsUtility.getFrameDuration());
 }
 
 void Level::leave()
 {
     setInputDisabled();
+    Application::instance().m_inputSession.endLevel();
+    Application::instance().m_frameTelemetry.endLevel();
+
+#ifdef DUMP_PROFILE_TRACE
+    // Trace is a debugging aid, failing to write it shouldn't stop the level transition
+    try
+    {
+        auto &profiler = Profiler::instance();
+        profiler.exportChromeTrace(Filesystem::getRootDirectory() + "trace.json", profiler.getOldestFrame(), profiler.getCurrentFrame());
+    }
+    catch (const std::exception &ex_)
+    {
+        LOG_ERROR("Failed to export trace: {}", ex_.what());
+    }
+#endif
 }
 
 LevelResult Level::proceed()
 {
-    Timer fullFrameTime;
+    Timer phaseTimer;
     auto &profiler = Profiler::instance();
+    auto &app = Application::instance();
+    const auto &inputSession = app.m_inputSession;
 
-    fullFrameTime.begin();
     while (m_state == STATE::RUNNING)
     {
+        FrameTimes frameTimes;
+        phaseTimer.begin();
+
         profiler.cleanFrame();
         m_input.handleInput();
 
@@ -45,9 +71,23 @@ LevelResult Level::proceed()
         {
             update();
             m_allowIter = false;
+
+            if (inputSession.isReplayFinished())
+            {
+                m_returnVal.nextLvl.reset();
+                m_state = STATE::LEAVE;
+            }
         }
 
+        frameTimes.m_update = phaseTimer.iterate();
+
         draw();
+
+        // Swap happens somewhere inside draw
+        frameTimes.m_swap = app.m_renderer.getLastSwapDuration();
+        frameTimes.m_draw = phaseTimer.iterate();
+        frameTimes.m_draw -= std::min(frameTimes.m_draw, frameTimes.m_swap);
+
         #ifdef DUMP_PROFILE_CONSOLE
         if (iterateCon)
         {
@@ -57,6 +97,8 @@ LevelResult Level::proceed()
         #endif
 
         m_fpsUtility.cycle();
+        frameTimes.m_sleep = m_fpsUtility.getLastSleepDuration();
+        app.m_frameTelemetry.addFrame(frameTimes);
     }
 
     leave();
@@ -64,6 +106,20 @@ LevelResult Level::proceed()
     return m_returnVal;
 }
 
+bool Level::simulateFrame()
+{
+    m_input.handleInput();
+    update();
+
+    if (Application::instance().m_inputSession.isReplayFinished())
+    {
+        m_returnVal.nextLvl.reset();
+        m_state = STATE::LEAVE;
+    }
+
+    return m_state == STATE::RUNNING;
+}
+
 std::string Level::name() const
 {
     return m_levelName;
@@ -18,6 +18,9 @@ public:
 
     virtual void enter();
     LevelResult proceed();
+
+    // Single update without drawing and frame limiting, returns false once level wants to leave
+    bool simulateFrame();
 	virtual void leave();
 
     std::string name() const;
@@ -15,6 +15,16 @@ void ll::setLang(const std::string &lang_)
         m_currentStrings = &m_stringsen;
 }
 
+size_t ll::count() noexcept
+{
+    return m_currentStrings->size();
+}
+
+const std::string &ll::get(size_t id_)
+{
+    return m_currentStrings->at(id_);
+}
+
 void ll::load()
 {
     {
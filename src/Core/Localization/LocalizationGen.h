@@ -14,6 +14,10 @@ public:
     static void setLang(const std::string &lang_);
     static void load();
 
+    // Strings of the current language by index, for systems that preprocess all of them
+    static size_t count() noexcept;
+    static const std::string &get(size_t id_);
+
     GENERATE_LOCALIZED_KEY(dbg_localization, 0)
     GENERATE_LOCALIZED_KEY(test_dlg1, 1)
     GENERATE_LOCALIZED_KEY(test_dlg2, 2)
@@ -25,6 +25,10 @@ public:
     static void setLang(const std::string &lang_);
     static void load();
 
+    // Strings of the current language by index, for systems that preprocess all of them
+    static size_t count() noexcept;
+    static const std::string &get(size_t id_);
+
 """)
         idx = 0
         for key in sorted(keys):
@@ -77,6 +81,16 @@ void ll::setLang(const std::string &lang_)
         m_currentStrings = &m_stringsen;
 }
 
+size_t ll::count() noexcept
+{
+    return m_currentStrings->size();
+}
+
+const std::string &ll::get(size_t id_)
+{
+    return m_currentStrings->at(id_);
+}
+
 void ll::load()
 {
 """)
@@ -1,4 +1,7 @@
-#include "Logger.h"
+#include "Logger.hpp"
+#include <cstdio>
+#include <ctime>
+#include <thread>
 
 std::string utils::prettifyFunction(const std::string &functionName_)
 {
@@ -38,3 +41,203 @@ std::string utils::cutBoundingSpaces(const std::string &functionName_)
 
     return dst;
 }
+
+namespace
+{
+    using Logger::detail::LogRecord;
+
+    // Set once backend is destroyed during static deinitialization, logs after that are printed synchronously
+    std::atomic<bool> backendDestroyed = false;
+
+    /*
+        Bounded lock-free multi-producer single-consumer ring
+        Producers only reserve a slot with a CAS and fill it, everything else happens on the logger thread
+    */
+    class AsyncBackend
+    {
+    public:
+        static constexpr uint64_t CAPACITY = 1 << 12;
+        static constexpr size_t FLUSH_THRESHOLD = 1 << 16;
+
+        AsyncBackend() :
+            m_records{std::make_unique<LogRecord[]>(CAPACITY)}
+        {
+            for (uint64_t i = 0; i < CAPACITY; ++i)
+                m_records[i].m_sequence.store(i, std::memory_order_relaxed);
+
+            m_thread = std::thread(&AsyncBackend::run, this);
+        }
+
+        ~AsyncBackend()
+        {
+            m_stop.store(true, std::memory_order_release);
+            m_thread.join();
+            backendDestroyed.store(true, std::memory_order_release);
+        }
+
+        LogRecord *acquire() noexcept
+        {
+            auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+            while (true)
+            {
+                auto &record = m_records[pos & (CAPACITY - 1)];
+                const auto seq = record.m_sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+
+                if (diff == 0)
+                {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        return &record;
+                }
+                else if (diff < 0)
+                {
+                    // Full, logger thread has to catch up
+                    std::this_thread::yield();
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+                }
+                else
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        void commit(LogRecord &record_) noexcept
+        {
+            const auto pos = record_.m_sequence.load(std::memory_order_relaxed);
+            record_.m_sequence.store(pos + 1, std::memory_order_release);
+        }
+
+        void flush() const
+        {
+            const auto target = m_enqueuePos.load(std::memory_order_acquire);
+            while (m_printedPos.load(std::memory_order_acquire) < target)
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+    private:
+        void run()
+        {
+            uint64_t pos = 0;
+            while (true)
+            {
+                auto &record = m_records[pos & (CAPACITY - 1)];
+                if (record.m_sequence.load(std::memory_order_acquire) == pos + 1)
+                {
+                    writeRecord(record);
+                    record.m_sequence.store(pos + CAPACITY, std::memory_order_release);
+                    pos++;
+
+                    if (m_buffer.size() >= FLUSH_THRESHOLD)
+                        output(pos);
+
+                    continue;
+                }
+
+                // Nothing to read, good time to print what was collected
+                output(pos);
+
+                if (m_stop.load(std::memory_order_acquire) && m_enqueuePos.load(std::memory_order_acquire) == pos)
+                    break;
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        void writeRecord(LogRecord &record_)
+        {
+            const auto now = std::chrono::system_clock::to_time_t(record_.m_time);
+            const auto mks = std::chrono::duration_cast<std::chrono::microseconds>(
+                record_.m_time.time_since_epoch()
+                ).count() % 1'000'000;
+
+            // Most records within a burst share the same second
+            if (now != m_cachedTime)
+            {
+                m_cachedTime = now;
+                localtime_s(&m_cachedTm, &now);
+            }
+
+            std::format_to(std::back_inserter(m_buffer), "{}.{:0>2}.{:0>2} {:0>2}:{:0>2}:{:0>2}.{:0>6} {} ",
+                m_cachedTm.tm_year + 1900, m_cachedTm.tm_mon + 1, m_cachedTm.tm_mday, m_cachedTm.tm_hour, m_cachedTm.tm_min, m_cachedTm.tm_sec, mks, serialize(record_.m_level));
+
+            if (record_.m_sourceLen > 0)
+                std::format_to(std::back_inserter(m_buffer), "[{}] ", std::string_view(record_.m_source, record_.m_sourceLen));
+
+            m_buffer += record_.m_funcName;
+            m_buffer += ": ";
+
+            if (record_.m_write)
+                record_.m_write(m_buffer, record_);
+            else
+                m_buffer += record_.m_format;
+
+            m_buffer += '\n';
+        }
+
+        void output(uint64_t printedPos_)
+        {
+            if (!m_buffer.empty())
+            {
+                std::fwrite(m_buffer.data(), 1, m_buffer.size(), stdout);
+                std::fflush(stdout);
+                m_buffer.clear();
+            }
+
+            m_printedPos.store(printedPos_, std::memory_order_release);
+        }
+
+        std::unique_ptr<LogRecord[]> m_records;
+        alignas(64) std::atomic<uint64_t> m_enqueuePos = 0;
+        alignas(64) std::atomic<uint64_t> m_printedPos = 0;
+        std::atomic<bool> m_stop = false;
+
+        // Logger thread only
+        std::string m_buffer;
+        std::time_t m_cachedTime = 0;
+        tm m_cachedTm = {};
+
+        std::thread m_thread;
+    };
+
+    AsyncBackend &backend()
+    {
+        static AsyncBackend instance;
+        return instance;
+    }
+}
+
+void Logger::setLevel(Level level_) noexcept
+{
+    detail::runtimeLevel.store(level_, std::memory_order_relaxed);
+}
+
+Logger::Level Logger::getLevel() noexcept
+{
+    return detail::runtimeLevel.load(std::memory_order_relaxed);
+}
+
+void Logger::flush()
+{
+    if (!backendDestroyed.load(std::memory_order_acquire))
+        backend().flush();
+}
+
+LogRecord *Logger::detail::acquireRecord() noexcept
+{
+    if (backendDestroyed.load(std::memory_order_acquire))
+        return nullptr;
+
+    return backend().acquire();
+}
+
+void Logger::detail::commitRecord(LogRecord &record_) noexcept
+{
+    backend().commit(record_);
+}
+
+void Logger::detail::writeSync(Level level_, std::string_view funcName_, std::string_view source_, std::string_view text_)
+{
+    if (source_.empty())
+        std::print("{} {}: {}\n", serialize(level_), funcName_, text_);
+    else
+        std::print("{} [{}] {}: {}\n", serialize(level_), source_, funcName_, text_);
+}
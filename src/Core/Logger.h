@@ -1,5 +1,6 @@
 #pragma once
 #include "StaticMapping.hpp"
+#include <atomic>
 #include <string>
 #include <string_view>
 #include <format>
@@ -16,6 +17,15 @@ namespace utils
     std::string cutBoundingSpaces(const std::string &functionName_);
 }
 
+// Logs below this level are not compiled at all, 0 - TRACE, 1 - INFO, 2 - WARNING, 3 - ERROR
+#ifndef LOG_COMPILE_LEVEL
+    #ifdef NDEBUG
+        #define LOG_COMPILE_LEVEL 1
+    #else
+        #define LOG_COMPILE_LEVEL 0
+    #endif
+#endif
+
 namespace Logger
 {
     enum class Level : uint8_t
@@ -26,6 +36,23 @@ namespace Logger
         ERROR = 3
     };
 
+    namespace detail
+    {
+        inline std::atomic<Level> runtimeLevel = Level::TRACE;
+    }
+
+    // Runtime filter on top of LOG_COMPILE_LEVEL
+    void setLevel(Level level_) noexcept;
+    Level getLevel() noexcept;
+
+    inline bool isEnabled(Level level_) noexcept
+    {
+        return level_ >= detail::runtimeLevel.load(std::memory_order_relaxed);
+    }
+
+    // Blocks until everything logged before the call is printed
+    void flush();
+
     template<typename... Args>
     void logImpl(const Level &level_, const std::string_view &funcName_, const std::string_view &text_);
 
@@ -43,15 +70,24 @@ SERIALIZE_ENUM(Logger::Level, {
     ENUM_INIT(Logger::Level, ERROR, "ERR")
 })
 
+/*
+    Arguments are only evaluated if the level passes both filters
+    Formatting and printing happen on the logger thread, see Logger.hpp
+*/
 #define LOG_IMPL(LVL, ...) \
-try { \
-    if (LVL >= Logger::Level::TRACE) \
+do { \
+    if constexpr (LVL >= static_cast<Logger::Level>(LOG_COMPILE_LEVEL)) \
     { \
-        Logger::logImpl(LVL, __func__, __VA_ARGS__); \
+        if (Logger::isEnabled(LVL)) \
+        { \
+            try { \
+                Logger::logImpl(LVL, __func__, __VA_ARGS__); \
+            } catch (const std::exception &ex_) { \
+                std::print("Error while printing log at {}:{}: {}", __FILE__, __LINE__, ex_.what()); \
+            } \
+        } \
     } \
-} catch (const std::exception &ex_) { \
-    std::print("Error while printing log at {}:{}: {}", __FILE__, __LINE__, ex_.what()); \
-}
+} while (false)
 
 #define LOG_TRACE(...) LOG_IMPL(Logger::Level::TRACE, __VA_ARGS__)
 #define LOG_INFO(...) LOG_IMPL(Logger::Level::INFO, __VA_ARGS__)
@@ -1,58 +1,133 @@
 #pragma once
 #include "Logger.h"
-#include <print>
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <print>
+#include <tuple>
+#include <type_traits>
 
 namespace Logger
 {
 
-    template<typename... Args>
-    void logImpl(const Level &level_, const std::string_view &funcName_, const std::string_view &text_)
+    namespace detail
     {
-        const auto nowts = std::chrono::system_clock::now();
-        const auto now = std::chrono::system_clock::to_time_t(nowts);
+        struct LogRecord;
+        using WritePayload = void(*)(std::string &out_, LogRecord &record_) noexcept;
 
-        const auto mks = std::chrono::duration_cast<std::chrono::microseconds>(
-            nowts.time_since_epoch()
-            ).count() % 1'000'000;
+        /*
+            Single slot of the ring between logging threads and the logger thread
+            Arguments are stored as is and formatted only on the logger thread
+        */
+        struct LogRecord
+        {
+            static constexpr size_t ARGS_CAPACITY = 192;
+            static constexpr size_t SOURCE_CAPACITY = 32;
 
-        tm now_t;
-        localtime_s(&now_t, &now);
+            // Vyukov's bounded queue: equals to slot index when free, index + 1 when filled
+            std::atomic<uint64_t> m_sequence = 0;
 
-        std::print("{}.{:0>2}.{:0>2} {:0>2}:{:0>2}:{:0>2}.{:0>6} {} {}: {}\n", now_t.tm_year + 1900, now_t.tm_mon + 1, now_t.tm_mday, now_t.tm_hour, now_t.tm_min, now_t.tm_sec, mks, serialize(level_), funcName_, text_);
-    }
+            std::chrono::system_clock::time_point m_time;
+            std::string_view m_funcName;
+            std::string_view m_format;
+            WritePayload m_write = nullptr;
+            Level m_level = Level::TRACE;
+            uint8_t m_sourceLen = 0;
+            char m_source[SOURCE_CAPACITY];
+            alignas(std::max_align_t) std::byte m_args[ARGS_CAPACITY];
+        };
 
-    template<typename... Args>
-    void logImpl(const Level &level_, const std::string_view &funcName_, const std::format_string<Args...> &text_, Args&&... args_) requires (sizeof...(Args) > 0)
-    {
-        const auto nowts = std::chrono::system_clock::now();
-        const auto now = std::chrono::system_clock::to_time_t(nowts);
+        // Returns free slot, waits if the ring is full. Returns nullptr if logger thread is not available anymore
+        LogRecord *acquireRecord() noexcept;
+        void commitRecord(LogRecord &record_) noexcept;
+
+        // Fallback for the time when logger thread is shut down
+        void writeSync(Level level_, std::string_view funcName_, std::string_view source_, std::string_view text_);
+
+        // Text can point to temporary buffers, so it's always copied
+        template<typename T>
+        using StoredArg = std::conditional_t<std::is_convertible_v<const T&, std::string_view>, std::string, std::decay_t<T>>;
+
+        template<typename... Stored>
+        void writePayload(std::string &out_, LogRecord &record_) noexcept
+        {
+            auto *args = std::launder(reinterpret_cast<std::tuple<Stored...>*>(record_.m_args));
+
+            try
+            {
+                std::apply([&](auto&... args_) {
+                    std::vformat_to(std::back_inserter(out_), record_.m_format, std::make_format_args(args_...));
+                }, *args);
+            }
+            catch (const std::exception &ex_)
+            {
+                out_ += std::format("<failed to format \"{}\": {}>", record_.m_format, ex_.what());
+            }
+
+            std::destroy_at(args);
+        }
+
+        template<typename... Stored, typename... Args>
+        void enqueue(Level level_, std::string_view funcName_, std::string_view source_, std::string_view format_, Args&&... args_)
+        {
+            using Payload = std::tuple<Stored...>;
 
-        const auto mks = std::chrono::duration_cast<std::chrono::microseconds>(
-            nowts.time_since_epoch()
-            ).count() % 1'000'000;
+            if constexpr (sizeof(Payload) > LogRecord::ARGS_CAPACITY || alignof(Payload) > alignof(std::max_align_t) || !std::is_constructible_v<Payload, Args&&...>)
+            {
+                // Doesn't fit into the record, have to format on the calling thread
+                enqueue<std::string>(level_, funcName_, source_, "{}", std::vformat(format_, std::make_format_args(args_...)));
+            }
+            else
+            {
+                auto *record = acquireRecord();
+                if (!record)
+                {
+                    writeSync(level_, funcName_, source_, std::vformat(format_, std::make_format_args(args_...)));
+                    return;
+                }
 
-        tm now_t;
-        localtime_s(&now_t, &now);
+                record->m_time = std::chrono::system_clock::now();
+                record->m_funcName = funcName_;
+                record->m_format = format_;
+                record->m_level = level_;
+                record->m_sourceLen = static_cast<uint8_t>(std::min(source_.size(), LogRecord::SOURCE_CAPACITY));
+                source_.copy(record->m_source, record->m_sourceLen);
 
-        std::print("{}.{:0>2}.{:0>2} {:0>2}:{:0>2}:{:0>2}.{:0>6} {} {}: {}\n", now_t.tm_year + 1900, now_t.tm_mon + 1, now_t.tm_mday, now_t.tm_hour, now_t.tm_min, now_t.tm_sec, mks, serialize(level_), funcName_, std::format(text_, std::forward<Args>(args_)...));
+                try
+                {
+                    std::construct_at(reinterpret_cast<Payload*>(record->m_args), std::forward<Args>(args_)...);
+                    record->m_write = &writePayload<Stored...>;
+                }
+                catch (...)
+                {
+                    // Slot is already taken and has to be committed anyway, only format string gets printed
+                    record->m_write = nullptr;
+                }
+
+                commitRecord(*record);
+            }
+        }
     }
 
     template<typename... Args>
-    void logImpl(const Level &level_, const std::string_view &funcName_, const ComponentName &source_, const std::format_string<Args...> &text_, Args&&... args_)
+    void logImpl(const Level &level_, const std::string_view &funcName_, const std::string_view &text_)
     {
-        const auto nowts = std::chrono::system_clock::now();
-        const auto now = std::chrono::system_clock::to_time_t(nowts);
-
-        const auto mks = std::chrono::duration_cast<std::chrono::microseconds>(
-            nowts.time_since_epoch()
-            ).count() % 1'000'000;
+        detail::enqueue<std::string>(level_, funcName_, {}, "{}", text_);
+    }
 
-        tm now_t;
-        localtime_s(&now_t, &now);
+    template<typename... Args>
+    void logImpl(const Level &level_, const std::string_view &funcName_, const std::format_string<Args...> &text_, Args&&... args_) requires (sizeof...(Args) > 0)
+    {
+        detail::enqueue<detail::StoredArg<Args>...>(level_, funcName_, {}, text_.get(), std::forward<Args>(args_)...);
+    }
 
-        std::print("{}.{:0>2}.{:0>2} {:0>2}:{:0>2}:{:0>2}.{:0>6} {} [{}] {}: {}\n", now_t.tm_year + 1900, now_t.tm_mon + 1, now_t.tm_mday, now_t.tm_hour, now_t.tm_min, now_t.tm_sec, mks, serialize(level_), source_.name, funcName_, std::format(text_, std::forward<Args>(args_)...));
+    template<typename... Args>
+    void logImpl(const Level &level_, const std::string_view &funcName_, const ComponentName &source_, const std::format_string<Args...> &text_, Args&&... args_)
+    {
+        detail::enqueue<detail::StoredArg<Args>...>(level_, funcName_, source_.name, text_.get(), std::forward<Args>(args_)...);
     }
 
 }
-
@@ -1,7 +1,7 @@
 #include "NavGraph.h"
 #include "Application.h"
 #include "Configuration.h"
-#include "TextManager.h"
+#include "TextManager.hpp"
 
 NavGraph::NavGraph() :
     m_ren(Application::instance().m_renderer),
@@ -50,12 +50,15 @@ void NavGraph::draw(const Camera &cam_) const
 {
     if (ConfigurationManager::instance().m_debug.m_drawNavGraph)
     {
+        // Labels go on top of everything in a single draw
+        m_textman.beginBatch();
+
         const Vector2<float> nodeSize{5.0f, 5.0f};
         for (size_t i = 0; i < m_nodes.size(); ++i)
         {
             const auto &node = m_nodes[i];
             m_ren.drawRectangle(node.m_position - nodeSize / 2.0f, nodeSize, {255, 127, 39, 255}, cam_);
-            m_textman.renderText<TextAligners::AlignerCenter>(std::to_string(i), Fonts::DBG_NAVSYS, node.m_position - Vector2{0, 12}, cam_);
+            m_textman.renderNumber<TextAligners::AlignerCenter>(static_cast<int64_t>(i), Fonts::DBG_NAVSYS, node.m_position - Vector2{0, 12}, cam_);
         }
     
         for (const auto &con : m_connections)
@@ -63,8 +66,10 @@ void NavGraph::draw(const Camera &cam_) const
             m_ren.drawLine(m_nodes[con.m_nodes[0]].m_position - Vector2{1.0f, 1.0f}, m_nodes[con.m_nodes[1]].m_position - Vector2{1.0f, 1.0f}, {255, 127, 39, 200}, cam_);
     
             auto center = (m_nodes[con.m_nodes[0]].m_position + m_nodes[con.m_nodes[1]].m_position) / 2.0f;
-            m_textman.renderText<TextAligners::AlignerCenter>(std::to_string(con.m_ownId), Fonts::DBG_NAVSYS, center - Vector2{0, 12}, cam_);
+            m_textman.renderNumber<TextAligners::AlignerCenter>(static_cast<int64_t>(con.m_ownId), Fonts::DBG_NAVSYS, center - Vector2{0, 12}, cam_);
         }
+
+        m_textman.endBatch();
     }
 }
 
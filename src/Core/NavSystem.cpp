@@ -73,6 +73,8 @@ void NavSystem::update()
 
 void NavSystem::draw(const Camera &cam_) const
 {
+    m_textman.beginBatch();
+
     if (ConfigurationManager::instance().m_debug.m_drawCurrentConnection)
     {
         const auto view = m_reg.view<ComponentTransform, Navigatable>();
@@ -154,6 +156,8 @@ void NavSystem::draw(const Camera &cam_) const
                 m_ren.drawCircleOutline(tarPos, path.m_targetMaxConnectionRange, {255, 150, 100, 200}, cam_);
         }
     }
+
+    m_textman.endBatch();
 }
 
 NavPath::Follower NavSystem::makePath(Traverse::TraitT traverseTraits_, entt::entity goal_, float maxTarRange_)
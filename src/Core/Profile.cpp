@@ -1,36 +1,62 @@
 #include "Profile.h"
 #include "Utils.hpp"
+#include <SDL3/SDL.h>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 
 TimeStatistic &TimeStatistic::operator+=(const uint64_t &rhs_) noexcept
 {
-    m_sum += rhs_;
-    m_cnt++;
+    m_sum.fetch_add(rhs_, std::memory_order_relaxed);
+    m_cnt.fetch_add(1, std::memory_order_relaxed);
     return *this;
 }
 
 uint64_t TimeStatistic::avg() const noexcept
 {
-    if (m_cnt == 0)
+    const auto cnt = m_cnt.load(std::memory_order_relaxed);
+    if (cnt == 0)
         return 0;
-    return m_sum / m_cnt;
+    return m_sum.load(std::memory_order_relaxed) / cnt;
 }
 
 uint64_t TimeStatistic::sum() const noexcept
 {
-    return m_sum;
+    return m_sum.load(std::memory_order_relaxed);
 }
 
 int TimeStatistic::count() const noexcept
 {
-    return m_cnt;
+    return static_cast<int>(m_cnt.load(std::memory_order_relaxed));
+}
+
+uint64_t TimeStatistic::prevSum() const noexcept
+{
+    return m_prevSum;
+}
+
+int TimeStatistic::prevCount() const noexcept
+{
+    return static_cast<int>(m_prevCnt);
 }
 
 void TimeStatistic::reset() noexcept
 {
-    m_sum = 0;
-    m_cnt = 0;
+    m_prevSum = m_sum.exchange(0, std::memory_order_relaxed);
+    m_prevCnt = m_cnt.exchange(0, std::memory_order_relaxed);
+}
+
+TraceRing::TraceRing(uint32_t threadId_) :
+    m_threadId{threadId_},
+    m_events(CAPACITY)
+{
+}
+
+void TraceRing::push(const TraceEvent &event_) noexcept
+{
+    const auto head = m_head.load(std::memory_order_relaxed);
+    m_events[head % CAPACITY] = event_;
+    m_head.store(head + 1, std::memory_order_release);
 }
 
 Profiler &Profiler::instance() noexcept
@@ -39,27 +65,128 @@ Profiler &Profiler::instance() noexcept
     return profiler;
 }
 
-void Profiler::addRecord(const size_t &id_, uint64_t duration_) noexcept
+void Profiler::addRecord(const CallData &place_, uint64_t begin_, uint64_t end_, uint32_t depth_, TraceRing &ring_) noexcept
 {
-    m_calls[id_].m_timeStat += duration_;
+    // Statistic is atomic and ring belongs to the calling thread, so no locks here
+    place_.m_timeStat += end_ - begin_;
+    ring_.push({begin_, end_, place_.m_id, depth_});
 }
 
-size_t Profiler::addName(const char *location_, const std::string &name_, int line_) noexcept
+const CallData &Profiler::addName(const char *location_, const std::string &name_, int line_) noexcept
 {
-    m_calls.emplace_back(name_, location_, line_);
+    std::lock_guard lock(m_mtx);
+
+    // Deque never moves elements, so references stay valid for the call sites
+    const auto &res = m_calls.emplace_back(name_, location_, line_, static_cast<uint32_t>(m_calls.size()));
     if (name_.size() > m_longestFuncName)
         m_longestFuncName = name_.size();
-    return m_calls.size() - 1;
+    return res;
+}
+
+TraceRing &Profiler::threadRing() noexcept
+{
+    thread_local TraceRing *ring = [this]() {
+        std::lock_guard lock(m_mtx);
+        m_rings.push_back(std::make_unique<TraceRing>(static_cast<uint32_t>(m_rings.size())));
+        return m_rings.back().get();
+    }();
+
+    return *ring;
 }
 
 void Profiler::cleanFrame() noexcept
 {
-#ifdef DUMP_PROFILE
+    // PROFILE_SYSTEM places are always measured, so their statistics roll over in every build
+    std::lock_guard lock(m_mtx);
     for (auto &el : m_calls)
         el.m_timeStat.reset();
+
+#ifdef DUMP_PROFILE_TRACE
+    m_currentFrame++;
+    m_frameStarts[m_currentFrame % FRAME_HISTORY] = SDL_GetTicksNS();
 #endif
 }
 
+uint64_t Profiler::getCurrentFrame() const noexcept
+{
+    return m_currentFrame;
+}
+
+uint64_t Profiler::getOldestFrame() const noexcept
+{
+    return (m_currentFrame >= FRAME_HISTORY ? m_currentFrame - FRAME_HISTORY + 1 : 1);
+}
+
+void Profiler::exportChromeTrace(const std::string &path_, uint64_t firstFrame_, uint64_t lastFrame_) const
+{
+    firstFrame_ = std::max(firstFrame_, getOldestFrame());
+    lastFrame_ = std::min(lastFrame_, m_currentFrame);
+    if (firstFrame_ > lastFrame_)
+        throw std::runtime_error(std::format("Frames {}-{} are not available for trace export, available frames: {}-{}",
+            firstFrame_, lastFrame_, getOldestFrame(), m_currentFrame));
+
+    const auto rangeBegin = m_frameStarts[firstFrame_ % FRAME_HISTORY];
+    const auto rangeEnd = (lastFrame_ == m_currentFrame ? SDL_GetTicksNS() : m_frameStarts[(lastFrame_ + 1) % FRAME_HISTORY]);
+
+    std::ofstream out(path_);
+    if (!out.is_open())
+        throw std::runtime_error(std::format("Failed to open \"{}\" to export trace", path_));
+
+    const auto escape = [](const std::string &str_) {
+        std::string res;
+        res.reserve(str_.size());
+        for (const auto &ch : str_)
+        {
+            if (ch == '"' || ch == '\\')
+                res += '\\';
+            res += ch;
+        }
+        return res;
+    };
+
+    std::lock_guard lock(m_mtx);
+
+    std::vector<std::string> names;
+    names.reserve(m_calls.size());
+    for (const auto &el : m_calls)
+        names.push_back(escape(el.m_funcName));
+
+    // Timestamps are in microseconds relative to the first exported frame
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    const auto writeEvent = [&](const std::string &event_) {
+        out << (first ? "\n" : ",\n") << event_;
+        first = false;
+    };
+
+    for (auto frame = firstFrame_; frame <= lastFrame_; ++frame)
+    {
+        const auto ts = static_cast<double>(m_frameStarts[frame % FRAME_HISTORY] - rangeBegin) / 1000.0;
+        writeEvent(std::format(R"({{"name":"Frame {}","ph":"i","s":"g","pid":0,"tid":0,"ts":{:.3f}}})", frame, ts));
+    }
+
+    for (const auto &ring : m_rings)
+    {
+        writeEvent(std::format(R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"Thread {}"}}}})",
+            ring->m_threadId, ring->m_threadId));
+
+        ring->forEach([&](const TraceEvent &ev_) {
+            if (ev_.m_begin < rangeBegin || ev_.m_begin >= rangeEnd)
+                return;
+
+            writeEvent(std::format(R"({{"name":"{}","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f},"args":{{"depth":{}}}}})",
+                names[ev_.m_placeId], ring->m_threadId,
+                static_cast<double>(ev_.m_begin - rangeBegin) / 1000.0,
+                static_cast<double>(ev_.m_end - ev_.m_begin) / 1000.0,
+                ev_.m_depth));
+        });
+    }
+
+    out << "\n]}\n";
+
+    LOG_INFO("Exported frames {}-{} to \"{}\"", firstFrame_, lastFrame_, path_);
+}
+
 
 void Profiler::dump() const noexcept
 {
@@ -79,17 +206,25 @@ void Profiler::dump() const noexcept
 #endif
 }
 
-ProfileTimer::ProfileTimer(const size_t &id_) noexcept :
-    m_id(id_)
+ProfileTimer::ProfileTimer(const CallData &place_) noexcept :
+    m_place(place_),
+#ifdef DUMP_PROFILE_TRACE
+    m_ring(Profiler::instance().threadRing()),
+    m_depth(m_ring.m_depth++),
+#endif
+    m_begin(SDL_GetTicksNS())
 {
-    begin();
-    m_stopped = false;
 }
 
 void ProfileTimer::stop() noexcept
 {
-    auto passed = getPassed();
-    Profiler::instance().addRecord(m_id, passed);
+#ifdef DUMP_PROFILE_TRACE
+    Profiler::instance().addRecord(m_place, m_begin, SDL_GetTicksNS(), m_depth, m_ring);
+    m_ring.m_depth--;
+#else
+    // Without tracing only the statistic of the place is needed
+    m_place.m_timeStat += SDL_GetTicksNS() - m_begin;
+#endif
     m_stopped = true;
 }
 
@@ -99,7 +234,7 @@ ProfileTimer::~ProfileTimer()
         stop();
 }
 
-size_t registerProfilePlace(const char *file_, const std::string &functionName_, int line_) noexcept
+const CallData &registerProfilePlace(const char *file_, const std::string &functionName_, int line_) noexcept
 {
     return Profiler::instance().addName(file_, functionName_, line_);
 }
@@ -1,15 +1,27 @@
 #pragma once
 #include "Timer.h"
 #include "Logger.h" // IWYU pragma: keep
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 //#define DUMP_PROFILE_CONSOLE
-//#define DUMP_PROFILE_UI // TODO:
+//#define DUMP_PROFILE_UI
+//#define DUMP_PROFILE_TRACE
 
-#if defined(DUMP_PROFILE_CONSOLE) || defined(DUMP_PROFILE_UI)
+// Overlay is for development and playtest builds only
+#if defined(DUMP_PROFILE_UI) && defined(NDEBUG)
+    #undef DUMP_PROFILE_UI
+#endif
+
+#if defined(DUMP_PROFILE_CONSOLE) || defined(DUMP_PROFILE_UI) || defined(DUMP_PROFILE_TRACE)
     #define DUMP_PROFILE
 #endif
 
+// Can be updated from any thread
 class TimeStatistic
 {
 public:
@@ -17,11 +29,18 @@ public:
     uint64_t avg() const noexcept;
     uint64_t sum() const noexcept;
     int count() const noexcept;
+
+    // Values before the last reset, always cover a whole frame
+    uint64_t prevSum() const noexcept;
+    int prevCount() const noexcept;
+
     void reset() noexcept;
 
 private:
-    uint64_t m_sum = 0;
-    uint64_t m_cnt = 0;
+    std::atomic<uint64_t> m_sum = 0;
+    std::atomic<uint64_t> m_cnt = 0;
+    uint64_t m_prevSum = 0;
+    uint64_t m_prevCnt = 0;
 };
 
 struct CallData
@@ -35,36 +54,107 @@ struct CallData
     [[maybe_unused]]
     const unsigned int m_line;
 
-    TimeStatistic m_timeStat;
+    const uint32_t m_id;
+
+    mutable TimeStatistic m_timeStat;
+};
+
+// Finished scope
+struct TraceEvent
+{
+    uint64_t m_begin;
+    uint64_t m_end;
+    uint32_t m_placeId;
+    uint32_t m_depth;
+};
+
+/*
+    Ring of finished scopes of a single thread, only that thread writes into it
+    Oldest events get overwritten, readers only look at the last CAPACITY events before the head
+*/
+class TraceRing
+{
+public:
+    static constexpr size_t CAPACITY = 1 << 16;
+
+    TraceRing(uint32_t threadId_);
+
+    void push(const TraceEvent &event_) noexcept;
+
+    template<typename FuncT>
+    void forEach(FuncT &&func_) const;
+
+    const uint32_t m_threadId;
+
+    // Current nesting level, only touched by the owning thread
+    uint32_t m_depth = 0;
+
+private:
+    std::vector<TraceEvent> m_events;
+    std::atomic<uint64_t> m_head = 0;
 };
 
-class ProfileTimer : public Timer
+class ProfileTimer
 {
 public:
-    ProfileTimer(const size_t &id_) noexcept;
+    ProfileTimer(const CallData &place_) noexcept;
     void stop() noexcept;
     ~ProfileTimer();
 
 private:
     bool m_stopped = false;
-    const size_t &m_id;
+    const CallData &m_place;
+#ifdef DUMP_PROFILE_TRACE
+    TraceRing &m_ring;
+    uint32_t m_depth;
+#endif
+    uint64_t m_begin;
 };
 
 class Profiler
 {
 public:
     static Profiler &instance() noexcept;
-    void addRecord(const size_t &id_, uint64_t duration_) noexcept;
-    size_t addName(const char *location_, const std::string &name_, int line_) noexcept;
+    void addRecord(const CallData &place_, uint64_t begin_, uint64_t end_, uint32_t depth_, TraceRing &ring_) noexcept;
+    const CallData &addName(const char *location_, const std::string &name_, int line_) noexcept;
     void cleanFrame() noexcept;
     void dump() const noexcept;
 
+    // Ring of the calling thread, created on first use
+    TraceRing &threadRing() noexcept;
+
+    // Iterates over all registered places in registration order
+    template<typename FuncT>
+    void forEachPlace(FuncT &&func_) const;
+
+    // Frame boundaries are only tracked with DUMP_PROFILE_TRACE
+    uint64_t getCurrentFrame() const noexcept;
+
+    // Oldest frame that is still fully covered by frame boundaries
+    uint64_t getOldestFrame() const noexcept;
+
+    /*
+        Writes all scopes from all threads that started within [firstFrame_, lastFrame_] in Chrome Trace Event format
+        Can be opened with chrome://tracing or ui.perfetto.dev
+        Should be called from the main thread between frames
+    */
+    void exportChromeTrace(const std::string &path_, uint64_t firstFrame_, uint64_t lastFrame_) const;
+
 private:
-    std::vector<CallData> m_calls;
+    static constexpr size_t FRAME_HISTORY = 1024;
+
+    std::deque<CallData> m_calls;
     size_t m_longestFuncName = 0;
+
+    std::vector<std::unique_ptr<TraceRing>> m_rings;
+    mutable std::mutex m_mtx;
+
+    // Frame start timestamps, m_frameStarts[frame % FRAME_HISTORY]
+    std::array<uint64_t, FRAME_HISTORY> m_frameStarts = {};
+    uint64_t m_currentFrame = 0;
 };
 
-size_t registerProfilePlace(const char *file_, const std::string &functionName_, int line_) noexcept;
+const CallData &registerProfilePlace(const char *file_, const std::string &functionName_, int line_) noexcept;
 
 #define STRINGIFY(x) #x
 #define TOSTRING(x) STRINGIFY(x)
@@ -82,13 +172,37 @@ size_t registerProfilePlace(const char *file_, const std::string &functionName_,
 #define FUNCNAME __FUNCSIG__
 #endif
 
+// Always measured, used for coarse per-system timings that headless runs report even without DUMP_PROFILE
+// Scopes only go into the trace rings with DUMP_PROFILE_TRACE, otherwise it is just a timer and a statistic update
+#define PROFILE_SYSTEM(name) static const auto &VARNAME(NAMEREG) = registerProfilePlace(FILENAME, name, LINENUM); \
+        ProfileTimer VARNAME(PROFILETMR)(VARNAME(NAMEREG));
+
 #ifdef DUMP_PROFILE
 
-#define PROFILE_FUNCTION static auto VARNAME(NAMEREG) = registerProfilePlace(FILENAME, utils::prettifyFunction(FUNCNAME), LINENUM); \
-        ProfileTimer VARNAME(PROFILETMR)(VARNAME(NAMEREG));
+#define PROFILE_SCOPE(name) PROFILE_SYSTEM(name)
+
+#define PROFILE_FUNCTION PROFILE_SCOPE(utils::prettifyFunction(FUNCNAME))
 
 #else
 
+#define PROFILE_SCOPE(name)
 #define PROFILE_FUNCTION
 
 #endif
+
+template<typename FuncT>
+void Profiler::forEachPlace(FuncT &&func_) const
+{
+    std::lock_guard lock(m_mtx);
+    for (const auto &el : m_calls)
+        func_(el);
+}
+
+template<typename FuncT>
+void TraceRing::forEach(FuncT &&func_) const
+{
+    const auto head = m_head.load(std::memory_order_acquire);
+    const auto first = (head > CAPACITY ? head - CAPACITY : 0);
+    for (auto i = first; i < head; ++i)
+        func_(m_events[i % CAPACITY]);
+}
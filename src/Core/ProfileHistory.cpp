@@ -0,0 +1,109 @@
+#include "ProfileHistory.h"
+#include <algorithm>
+
+void ProfileHistory::collect(uint64_t frameTime_)
+{
+    m_frameTimes[m_head] = frameTime_;
+
+    Profiler::instance().forEachPlace([&](const CallData &place_) {
+        // Places that appeared later have zeros for the frames before their registration
+        const auto placeIdx = static_cast<size_t>(place_.m_id);
+        if (placeIdx >= m_placeTimes.size())
+        {
+            m_placeTimes.resize(placeIdx + 1, {});
+            m_placeCalls.resize(placeIdx + 1, {});
+            m_summary.resize(placeIdx + 1);
+        }
+
+        if (m_summary[placeIdx].m_name.empty())
+            m_summary[placeIdx].m_name = place_.m_funcName;
+
+        m_placeTimes[placeIdx][m_head] = place_.m_timeStat.prevSum();
+        m_placeCalls[placeIdx][m_head] = static_cast<uint32_t>(place_.m_timeStat.prevCount());
+    });
+
+    m_head = (m_head + 1) % FRAMES;
+    m_filled = std::min(m_filled + 1, FRAMES);
+}
+
+void ProfileHistory::summarize()
+{
+    if (m_filled == 0)
+        return;
+
+    const size_t last = (m_head + FRAMES - 1) % FRAMES;
+
+    // Until the ring wraps around, head is equal to m_filled, so the first m_filled elements are always valid
+    const auto worst = std::max_element(m_frameTimes.begin(), m_frameTimes.begin() + m_filled);
+    const auto worstIdx = static_cast<size_t>(worst - m_frameTimes.begin());
+    m_worstFrameTime = *worst;
+    m_framePercentiles = calculatePercentiles(m_frameTimes.data());
+
+    for (size_t i = 0; i < m_summary.size(); ++i)
+    {
+        auto &summary = m_summary[i];
+        const auto &times = m_placeTimes[i];
+        const auto &calls = m_placeCalls[i];
+
+        uint64_t timeSum = 0;
+        uint64_t callSum = 0;
+        for (size_t frame = 0; frame < m_filled; ++frame)
+        {
+            timeSum += times[frame];
+            callSum += calls[frame];
+        }
+
+        summary.m_last = times[last];
+        summary.m_avg = timeSum / m_filled;
+        summary.m_callsPerFrame = static_cast<float>(callSum) / static_cast<float>(m_filled);
+        summary.m_inWorstFrame = times[worstIdx];
+        summary.m_percentiles = calculatePercentiles(times.data());
+    }
+}
+
+ProfileHistory::Percentiles ProfileHistory::calculatePercentiles(const uint64_t *samples_)
+{
+    m_scratch.assign(samples_, samples_ + m_filled);
+
+    // Nearest rank, each nth_element only has to look at the part that's left after the previous one
+    const auto rank = [&](size_t percentile_) {
+        return std::min(m_filled - 1, (m_filled * percentile_ + 99) / 100 - 1);
+    };
+
+    Percentiles res;
+    const auto p50 = m_scratch.begin() + static_cast<int64_t>(rank(50));
+    const auto p95 = m_scratch.begin() + static_cast<int64_t>(rank(95));
+    const auto p99 = m_scratch.begin() + static_cast<int64_t>(rank(99));
+
+    std::nth_element(m_scratch.begin(), p50, m_scratch.end());
+    res.p50 = *p50;
+    std::nth_element(p50, p95, m_scratch.end());
+    res.p95 = *p95;
+    std::nth_element(p95, p99, m_scratch.end());
+    res.p99 = *p99;
+
+    return res;
+}
+
+uint64_t ProfileHistory::getLastTime(size_t place_) const noexcept
+{
+    if (m_filled == 0 || place_ >= m_placeTimes.size())
+        return 0;
+
+    return m_placeTimes[place_][(m_head + FRAMES - 1) % FRAMES];
+}
+
+const ProfileHistory::Percentiles &ProfileHistory::getFramePercentiles() const noexcept
+{
+    return m_framePercentiles;
+}
+
+uint64_t ProfileHistory::getWorstFrameTime() const noexcept
+{
+    return m_worstFrameTime;
+}
+
+const std::vector<ProfileHistory::PlaceSummary> &ProfileHistory::getPlaces() const noexcept
+{
+    return m_summary;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "Profile.h"
+#include <array>
+#include <string_view>
+#include <vector>
+
+/*
+    Keeps per-place times of the last FRAMES frames taken from Profiler
+    collect() is cheap and should be called once per frame, it takes statistics of the last finished frame
+    summarize() sorts samples and is meant to be called only when the results are going to be shown
+*/
+class ProfileHistory
+{
+public:
+    static constexpr size_t FRAMES = 240;
+
+    struct Percentiles
+    {
+        uint64_t p50 = 0;
+        uint64_t p95 = 0;
+        uint64_t p99 = 0;
+    };
+
+    struct PlaceSummary
+    {
+        std::string_view m_name;
+        uint64_t m_last = 0;
+        uint64_t m_avg = 0;
+        float m_callsPerFrame = 0.0f;
+        uint64_t m_inWorstFrame = 0;
+        Percentiles m_percentiles;
+    };
+
+    // frameTime_ should also belong to the last finished frame
+    void collect(uint64_t frameTime_);
+    void summarize();
+
+    const Percentiles &getFramePercentiles() const noexcept;
+    uint64_t getWorstFrameTime() const noexcept;
+
+    // Indexed by CallData::m_id, so in registration order, same as Profiler
+    const std::vector<PlaceSummary> &getPlaces() const noexcept;
+
+    // Time of the place in the last collected frame, doesn't need summarize()
+    uint64_t getLastTime(size_t place_) const noexcept;
+
+private:
+    Percentiles calculatePercentiles(const uint64_t *samples_);
+
+    std::array<uint64_t, FRAMES> m_frameTimes = {};
+    std::vector<std::array<uint64_t, FRAMES>> m_placeTimes;
+    std::vector<std::array<uint32_t, FRAMES>> m_placeCalls;
+    size_t m_head = 0;
+    size_t m_filled = 0;
+
+    Percentiles m_framePercentiles;
+    uint64_t m_worstFrameTime = 0;
+    std::vector<PlaceSummary> m_summary;
+    std::vector<uint64_t> m_scratch;
+};
@@ -0,0 +1,153 @@
+#include "PropSet.h"
+#include <algorithm>
+#include <cassert>
+#include <format>
+#include <limits>
+#include <stdexcept>
+
+PropSet::PropSet(ResID kind_) :
+    m_kind(kind_)
+{
+}
+
+uint8_t PropSet::addClip(AnimationManager &animationManager_, ResID id_, LOOPMETHOD isLoop_)
+{
+    if (m_clips.size() > std::numeric_limits<uint8_t>::max())
+        throw std::runtime_error(std::format("Prop set {} cannot have more than {} clips", m_kind, std::numeric_limits<uint8_t>::max() + 1));
+
+    auto textures = animationManager_.getTextureArr(id_);
+    const auto firstTexture = m_textureCount;
+    m_textureCount += static_cast<uint32_t>(textures->m_tex.size());
+
+    m_clips.push_back({std::move(textures), isLoop_, firstTexture});
+    return static_cast<uint8_t>(m_clips.size() - 1);
+}
+
+uint32_t PropSet::addInstance(const Vector2<int> &pos_, uint8_t clip_)
+{
+    assert(clip_ < m_clips.size());
+
+    m_positions.push_back(pos_);
+    m_instanceClips.push_back(clip_);
+    m_startTicks.push_back(Animation::getGlobalTick());
+
+    return static_cast<uint32_t>(m_positions.size() - 1);
+}
+
+void PropSet::setClip(uint32_t instance_, uint8_t clip_)
+{
+    assert(clip_ < m_clips.size());
+
+    m_instanceClips[instance_] = clip_;
+    m_startTicks[instance_] = Animation::getGlobalTick();
+}
+
+uint8_t PropSet::getClip(uint32_t instance_) const
+{
+    return m_instanceClips[instance_];
+}
+
+bool PropSet::isClipFinished(uint32_t instance_) const
+{
+    const auto &clip = m_clips[m_instanceClips[instance_]];
+    return Animation::isFinished(clip.m_textures->duration(), getState(instance_));
+}
+
+Vector2<int> PropSet::getSize(uint8_t clip_) const
+{
+    const auto &textures = *m_clips[clip_].m_textures;
+    return {textures.m_w, textures.m_h};
+}
+
+Vector2<int> PropSet::getOrigin(uint8_t clip_) const
+{
+    return m_clips[clip_].m_textures->m_origin;
+}
+
+ResID PropSet::getKind() const noexcept
+{
+    return m_kind;
+}
+
+size_t PropSet::size() const noexcept
+{
+    return m_positions.size();
+}
+
+size_t PropSet::getClipCount() const noexcept
+{
+    return m_clips.size();
+}
+
+const std::vector<PropBatch> &PropSet::buildBatches(const Collider &view_) const
+{
+    m_keys.clear();
+    m_visible.clear();
+    m_batches.clear();
+    m_culled = 0;
+    m_counts.assign(m_textureCount + 1, 0);
+
+    for (uint32_t i = 0; i < m_positions.size(); ++i)
+    {
+        const auto &clip = m_clips[m_instanceClips[i]];
+        const auto &textures = *clip.m_textures;
+
+        // Same placement as a single sprite facing right
+        const Collider bounds{m_positions[i] + Vector2{1, 1} - textures.m_origin, {textures.m_w, textures.m_h}};
+        if ((view_.checkOverlap(bounds) & OverlapResult::OVERLAP_BOTH) != OverlapResult::OVERLAP_BOTH)
+        {
+            m_culled++;
+            continue;
+        }
+
+        const auto frame = static_cast<size_t>(getState(i).m_frame);
+        const auto key = clip.m_firstTexture + static_cast<uint32_t>(textures.m_framesData[std::min(frame, textures.m_framesData.size() - 1)]);
+        m_keys.push_back(key);
+        m_visible.push_back(i);
+        m_counts[key + 1]++;
+    }
+
+    // Counting sort by texture, m_counts turns into the first slot of each texture
+    for (uint32_t i = 1; i < m_counts.size(); ++i)
+        m_counts[i] += m_counts[i - 1];
+
+    m_batchPositions.resize(m_visible.size());
+    for (const auto &clip : m_clips)
+    {
+        const auto &textures = *clip.m_textures;
+        for (uint32_t tex = 0; tex < textures.m_tex.size(); ++tex)
+        {
+            const auto key = clip.m_firstTexture + tex;
+            const auto count = m_counts[key + 1] - m_counts[key];
+            if (count > 0)
+                m_batches.push_back({textures.m_tex[tex], {textures.m_w, textures.m_h}, m_counts[key], count});
+        }
+    }
+
+    for (uint32_t i = 0; i < m_visible.size(); ++i)
+    {
+        const auto instance = m_visible[i];
+        const auto &textures = *m_clips[m_instanceClips[instance]].m_textures;
+        m_batchPositions[m_counts[m_keys[i]]++] = Vector2<float>(m_positions[instance] + Vector2{1, 1} - textures.m_origin);
+    }
+
+    return m_batches;
+}
+
+const std::vector<Vector2<float>> &PropSet::getBatchPositions() const noexcept
+{
+    return m_batchPositions;
+}
+
+uint32_t PropSet::getCulledCount() const noexcept
+{
+    return m_culled;
+}
+
+Animation::State PropSet::getState(uint32_t instance_) const
+{
+    // Same as a default constructed or reset Animation, so the first frame is shown on the tick the clip was started
+    const auto &clip = m_clips[m_instanceClips[instance_]];
+    const auto ticks = Animation::getGlobalTick() - m_startTicks[instance_];
+    return Animation::evaluate(clip.m_textures->duration(), clip.m_isLoop, {-1, 1}, ticks);
+}
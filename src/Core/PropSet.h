@@ -0,0 +1,79 @@
+#pragma once
+#include "AnimationManager.h"
+#include "Collider.h"
+#include <memory>
+#include <vector>
+
+struct PropClip
+{
+    std::shared_ptr<TextureArr> m_textures;
+    LOOPMETHOD m_isLoop;
+
+    // First texture of the clip in the dense index over textures of all clips
+    uint32_t m_firstTexture;
+};
+
+// Instances that show the same texture, drawn with a single call
+struct PropBatch
+{
+    unsigned int m_texture;
+    Vector2<int> m_size;
+    uint32_t m_first;
+    uint32_t m_count;
+};
+
+/*
+    Many copies of the same animated prop, like grass, stored as plain arrays instead of an entity with renderable per copy
+    Each instance only keeps its position, current clip and the global tick the clip was started at,
+        frame is evaluated from the global animation tick the same way Animation does
+    For drawing, visible instances are grouped by the texture they currently show so each texture is drawn once
+*/
+class PropSet
+{
+public:
+    PropSet(ResID kind_);
+
+    // Clips are identified by the order they were added in
+    uint8_t addClip(AnimationManager &animationManager_, ResID id_, LOOPMETHOD isLoop_);
+
+    // pos_ is the same position transform of a regular entity would have
+    uint32_t addInstance(const Vector2<int> &pos_, uint8_t clip_);
+
+    // Restarts the instance from the first frame of clip_
+    void setClip(uint32_t instance_, uint8_t clip_);
+    uint8_t getClip(uint32_t instance_) const;
+    bool isClipFinished(uint32_t instance_) const;
+
+    Vector2<int> getSize(uint8_t clip_) const;
+    Vector2<int> getOrigin(uint8_t clip_) const;
+
+    ResID getKind() const noexcept;
+    size_t size() const noexcept;
+    size_t getClipCount() const noexcept;
+
+    // Groups instances overlapping view_ by texture, batches point into getBatchPositions() and stay valid until the next call
+    const std::vector<PropBatch> &buildBatches(const Collider &view_) const;
+    const std::vector<Vector2<float>> &getBatchPositions() const noexcept;
+
+    // Instances skipped by the last buildBatches
+    uint32_t getCulledCount() const noexcept;
+
+private:
+    Animation::State getState(uint32_t instance_) const;
+
+    ResID m_kind;
+    std::vector<PropClip> m_clips;
+    uint32_t m_textureCount = 0;
+
+    std::vector<Vector2<int>> m_positions;
+    std::vector<uint8_t> m_instanceClips;
+    std::vector<uint32_t> m_startTicks;
+
+    // Scratch for batching, kept between frames to avoid allocations
+    mutable std::vector<uint32_t> m_keys;
+    mutable std::vector<uint32_t> m_visible;
+    mutable std::vector<uint32_t> m_counts;
+    mutable std::vector<PropBatch> m_batches;
+    mutable std::vector<Vector2<float>> m_batchPositions;
+    mutable uint32_t m_culled = 0;
+};
@@ -0,0 +1,112 @@
+#include "RenderQueue.h"
+#include "CoreComponents.h"
+#include <algorithm>
+
+RenderQueue::RenderQueue(entt::registry &reg_) :
+    m_reg{reg_}
+{
+    for (const auto &[ent, layer] : m_reg.view<RenderLayer>().each())
+        insert(ent, layer.getDepth());
+
+    m_reg.on_construct<RenderLayer>().connect<&RenderQueue::onConstruct>(*this);
+    m_reg.on_update<RenderLayer>().connect<&RenderQueue::onUpdate>(*this);
+    m_reg.on_destroy<RenderLayer>().connect<&RenderQueue::onDestroy>(*this);
+}
+
+RenderQueue::~RenderQueue()
+{
+    m_reg.on_construct<RenderLayer>().disconnect<&RenderQueue::onConstruct>(*this);
+    m_reg.on_update<RenderLayer>().disconnect<&RenderQueue::onUpdate>(*this);
+    m_reg.on_destroy<RenderLayer>().disconnect<&RenderQueue::onDestroy>(*this);
+}
+
+size_t RenderQueue::size() const noexcept
+{
+    return m_size;
+}
+
+void RenderQueue::onConstruct(entt::registry &reg_, entt::entity ent_)
+{
+    insert(ent_, reg_.get<RenderLayer>(ent_).getDepth());
+}
+
+void RenderQueue::onUpdate(entt::registry &reg_, entt::entity ent_)
+{
+    const auto depth = reg_.get<RenderLayer>(ent_).getDepth();
+    const auto &node = m_nodes[nodeOf(ent_)];
+    if (node.m_bucket != INVALID && m_buckets[node.m_bucket].m_depth == depth)
+        return;
+
+    remove(ent_);
+    insert(ent_, depth);
+}
+
+void RenderQueue::onDestroy(entt::registry&, entt::entity ent_)
+{
+    remove(ent_);
+}
+
+void RenderQueue::insert(entt::entity ent_, int depth_)
+{
+    const auto bucketId = getBucket(depth_);
+    const auto nodeId = nodeOf(ent_);
+    auto &bucket = m_buckets[bucketId];
+
+    m_nodes[nodeId] = {ent_, bucketId, bucket.m_tail, INVALID};
+
+    if (bucket.m_tail != INVALID)
+        m_nodes[bucket.m_tail].m_next = nodeId;
+    else
+        bucket.m_head = nodeId;
+
+    bucket.m_tail = nodeId;
+    m_size++;
+}
+
+void RenderQueue::remove(entt::entity ent_)
+{
+    const auto nodeId = nodeOf(ent_);
+    auto &node = m_nodes[nodeId];
+    if (node.m_bucket == INVALID)
+        return;
+
+    auto &bucket = m_buckets[node.m_bucket];
+
+    if (node.m_prev != INVALID)
+        m_nodes[node.m_prev].m_next = node.m_next;
+    else
+        bucket.m_head = node.m_next;
+
+    if (node.m_next != INVALID)
+        m_nodes[node.m_next].m_prev = node.m_prev;
+    else
+        bucket.m_tail = node.m_prev;
+
+    node = {};
+    m_size--;
+}
+
+uint32_t RenderQueue::getBucket(int depth_)
+{
+    const auto pos = std::lower_bound(m_order.begin(), m_order.end(), depth_, [this](uint32_t bucketId_, int value_) {
+        return m_buckets[bucketId_].m_depth > value_;
+    });
+
+    if (pos != m_order.end() && m_buckets[*pos].m_depth == depth_)
+        return *pos;
+
+    const auto bucketId = static_cast<uint32_t>(m_buckets.size());
+    m_buckets.emplace_back().m_depth = depth_;
+    m_order.insert(pos, bucketId);
+
+    return bucketId;
+}
+
+uint32_t RenderQueue::nodeOf(entt::entity ent_)
+{
+    const auto idx = static_cast<uint32_t>(entt::to_entity(ent_));
+    if (idx >= m_nodes.size())
+        m_nodes.resize(idx + 1);
+
+    return idx;
+}
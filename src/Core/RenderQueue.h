@@ -0,0 +1,74 @@
+#pragma once
+#include <entt/entt.hpp>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/*
+    Draw order of entities with RenderLayer, kept up to date through registry signals instead of sorting the registry
+    Entities are grouped into buckets by depth, buckets go from the furthest to the closest
+    Within a bucket entities keep the order in which they got their RenderLayer, so the order is stable between frames
+    Each bucket is an intrusive list over per-entity nodes, so both insertion and removal are O(1)
+*/
+class RenderQueue
+{
+public:
+    RenderQueue(entt::registry &reg_);
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue &operator=(const RenderQueue&) = delete;
+    ~RenderQueue();
+
+    // func_(entity, depth) for every entity in draw order
+    template<typename FuncT>
+    void forEach(FuncT &&func_) const;
+
+    size_t size() const noexcept;
+
+private:
+    static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+    struct Bucket
+    {
+        int m_depth = 0;
+        uint32_t m_head = INVALID;
+        uint32_t m_tail = INVALID;
+    };
+
+    // Indexed by entity index without version
+    struct Node
+    {
+        entt::entity m_entity = entt::null;
+        uint32_t m_bucket = INVALID;
+        uint32_t m_prev = INVALID;
+        uint32_t m_next = INVALID;
+    };
+
+    void onConstruct(entt::registry &reg_, entt::entity ent_);
+    void onUpdate(entt::registry &reg_, entt::entity ent_);
+    void onDestroy(entt::registry &reg_, entt::entity ent_);
+
+    void insert(entt::entity ent_, int depth_);
+    void remove(entt::entity ent_);
+    uint32_t getBucket(int depth_);
+    uint32_t nodeOf(entt::entity ent_);
+
+    entt::registry &m_reg;
+
+    // Bucket indices never change, new depths are rare, so only m_order has to be kept sorted
+    std::vector<Bucket> m_buckets;
+    std::vector<uint32_t> m_order;
+
+    std::vector<Node> m_nodes;
+    size_t m_size = 0;
+};
+
+template<typename FuncT>
+void RenderQueue::forEach(FuncT &&func_) const
+{
+    for (const auto bucketId : m_order)
+    {
+        const auto &bucket = m_buckets[bucketId];
+        for (auto nodeId = bucket.m_head; nodeId != INVALID; nodeId = m_nodes[nodeId].m_next)
+            func_(m_nodes[nodeId].m_entity, bucket.m_depth);
+    }
+}
@@ -7,17 +7,29 @@
 #include <SDL3/SDL_opengl.h>
 #include <stdexcept>
 #include <array>
+#include <cstddef>
+
+namespace
+{
+    bool contextCreated = false;
+}
 
 Renderer::Renderer(const Window &window_) :
-    m_window(window_),
-    m_context(SDL_GL_CreateContext( window_.getWindow() )) // SDL_GL_DestroyContext()
+    m_window(window_)
 {
+    // Null renderer for headless runs: nothing is created on GPU and nothing can be drawn
+    if (!window_.getWindow())
+        return;
+
+    m_context = SDL_GL_CreateContext( window_.getWindow() ); // SDL_GL_DestroyContext()
     if (!m_context)
         throw std::runtime_error(std::format("Failed to initialize context: {}", SDL_GetError()));
 
     if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(SDL_GL_GetProcAddress)))
         throw std::runtime_error("Failed to initialize GLAD");
 
+    contextCreated = true;
+
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
@@ -27,6 +39,8 @@ Renderer::Renderer(const Window &window_) :
     m_spriteShader.load(Filesystem::getRootDirectory() + "/src/core/Shader/Sprite.vert", Filesystem::getRootDirectory() + "/src/core/Shader/Sprite.frag");
     m_spriteShaderFlash.load(Filesystem::getRootDirectory() + "/src/core/Shader/Sprite.vert", Filesystem::getRootDirectory() + "/src/core/Shader/SpriteFlash.frag");
     m_spriteShaderRotate.load(Filesystem::getRootDirectory() + "/src/core/Shader/SpriteRotate.vert", Filesystem::getRootDirectory() + "/src/core/Shader/Sprite.frag");
+    m_spriteInstancedShader.load(Filesystem::getRootDirectory() + "/src/core/Shader/SpriteInstanced.vert", Filesystem::getRootDirectory() + "/src/core/Shader/Sprite.frag");
+    m_batchShader.load(Filesystem::getRootDirectory() + "/src/core/Shader/Batch.vert", Filesystem::getRootDirectory() + "/src/core/Shader/Batch.frag");
     m_spriteOutlinedShader.load(Filesystem::getRootDirectory() + "/src/core/Shader/Sprite.vert", Filesystem::getRootDirectory() + "/src/core/Shader/SpriteOutlined.frag");
     m_tileShader.load(Filesystem::getRootDirectory() + "/src/core/Shader/Tilemap.vert", Filesystem::getRootDirectory() + "/src/core/Shader/Sprite.frag");
     m_circleShader.load(Filesystem::getRootDirectory() + "/src/core/Shader/Rect.vert", Filesystem::getRootDirectory() + "/src/core/Shader/Circle.frag");
@@ -103,6 +117,43 @@ Renderer::Renderer(const Window &window_) :
     glBindVertexArray(0);
 
 
+    // instanced sprite, same quad and a position per instance
+    static_assert(sizeof(Vector2<float>) == 2 * sizeof(float));
+    glGenVertexArrays(1, &m_spriteInstancedVAO);
+    glGenBuffers(1, &m_instanceVBO);
+    glBindVertexArray(m_spriteInstancedVAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, spriteVBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glVertexAttribDivisor(1, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+
+    // batch, vertices are uploaded with each draw
+    static_assert(sizeof(BatchVertex) == 5 * sizeof(float));
+    glGenVertexArrays(1, &m_batchVAO);
+    glGenBuffers(1, &m_batchVBO);
+    glBindVertexArray(m_batchVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_batchVBO);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), reinterpret_cast<void*>(offsetof(BatchVertex, u)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), reinterpret_cast<void*>(offsetof(BatchVertex, alpha)));
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+
     // Projection matrix
     glm::mat4 projection = glm::ortho(0.0f, 640.0f,
         360.0f, 0.0f, -1.0f, 1.0f);
@@ -126,6 +177,15 @@ Renderer::Renderer(const Window &window_) :
     m_spriteShaderFlash.setInteger("image", 0);
     m_spriteShaderFlash.setMatrix4("projection", projection);
 
+    m_spriteInstancedShader.use();
+    m_spriteInstancedShader.setInteger("image", 0);
+    m_spriteInstancedShader.setMatrix4("projection", projection);
+    m_spriteInstancedShader.setFloat("alphaMod", 1.0f);
+
+    m_batchShader.use();
+    m_batchShader.setInteger("image", 0);
+    m_batchShader.setMatrix4("projection", projection);
+
     m_spriteShaderRotate.use();
     m_spriteShaderRotate.setInteger("image", 0);
     m_spriteShaderRotate.setMatrix4("projection", projection);
@@ -200,6 +260,8 @@ std::vector<unsigned int> Renderer::surfacesToTexture(const std::vector<SDL_Surf
     }
 
     std::vector<unsigned int> ids(surfaces_.size(), 0);
+    if (!hasContext())
+        return ids;
 
     glGenTextures(static_cast<int>(surfaces_.size()), ids.data());
 
@@ -221,6 +283,11 @@ std::vector<unsigned int> Renderer::surfacesToTexture(const std::vector<SDL_Surf
     return ids;
 }
 
+bool Renderer::hasContext() noexcept
+{
+    return contextCreated;
+}
+
 void Renderer::setTarget(const Texture &texture_)
 {
     selectTarget(m_customFB, texture_.size());
@@ -257,6 +324,12 @@ void Renderer::selectTarget(const Framebuffer &fb_, const Vector2<int> &size_)
 
     m_spriteShaderRotate.use();
     m_spriteShaderRotate.setMatrix4("projection", projection);
+
+    m_spriteInstancedShader.use();
+    m_spriteInstancedShader.setMatrix4("projection", projection);
+
+    m_batchShader.use();
+    m_batchShader.setMatrix4("projection", projection);
 }
 
 void Renderer::switchToWorld(const Color &col_)
@@ -309,7 +382,14 @@ void Renderer::updateScreen(const Camera &cam_)
     glBindTexture(GL_TEXTURE_2D, m_renderDbgTargetTexture.handler());
     glDrawArrays(GL_TRIANGLES, 0, 6);
 
+    const auto swapBegin = SDL_GetTicksNS();
     SDL_GL_SwapWindow( m_window.getWindow() );
+    m_lastSwapDuration = SDL_GetTicksNS() - swapBegin;
+}
+
+uint64_t Renderer::getLastSwapDuration() const noexcept
+{
+    return m_lastSwapDuration;
 }
 
 void Renderer::drawRectangle(const Vector2<int> &pos_, const Vector2<int> &size_, const Color &col_)
@@ -689,3 +769,67 @@ void Renderer::renderTile(const unsigned int tex_, const Vector2<int> &pos_, con
 
     glDrawArrays(GL_TRIANGLES, 0, 6);
 }
+
+void Renderer::renderTextureInstanced(const unsigned int tex_, const Vector2<float> *positions_, size_t count_, const Vector2<int> &size_, SDL_FlipMode flip_, const Camera &cam_)
+{
+    if (count_ == 0)
+        return;
+
+    glBindVertexArray(m_spriteInstancedVAO);
+    m_spriteInstancedShader.use();
+
+    int top = 0, bot = 0, lft = 0, rgt = 0;
+    if (flip_ & SDL_FLIP_VERTICAL)
+    {
+        top = size_.y;
+        bot = 0;
+    }
+    else
+    {
+        top = 0;
+        bot = size_.y;
+    }
+    if (flip_ & SDL_FLIP_HORIZONTAL)
+    {
+        lft = size_.x;
+        rgt = 0;
+    }
+    else
+    {
+        lft = 0;
+        rgt = size_.x;
+    }
+
+    const auto camTL = Vector2<int>(cam_.getPos() - gamedata::global::maxCameraSize / 2.0f);
+
+    m_spriteInstancedShader.setVector2f("vertices[0]", lft, top);
+    m_spriteInstancedShader.setVector2f("vertices[1]", rgt, top);
+    m_spriteInstancedShader.setVector2f("vertices[2]", rgt, bot);
+    m_spriteInstancedShader.setVector2f("vertices[3]", lft, bot);
+    m_spriteInstancedShader.setVector2f("offset", -camTL.x, -camTL.y);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(count_ * sizeof(Vector2<float>)), positions_, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindTexture(GL_TEXTURE_2D, tex_);
+
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(count_));
+}
+
+void Renderer::renderBatch(const unsigned int tex_, const BatchVertex *vertices_, size_t count_)
+{
+    if (count_ == 0)
+        return;
+
+    glBindVertexArray(m_batchVAO);
+    m_batchShader.use();
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_batchVBO);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(count_ * sizeof(BatchVertex)), vertices_, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindTexture(GL_TEXTURE_2D, tex_);
+
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(count_));
+}
@@ -9,6 +9,14 @@
 #include "Framebuffer.h"
 #include <SDL3/SDL.h>
 
+// Vertex of a textured quad batch, position is in pixels of the current target
+struct BatchVertex
+{
+    float x, y;
+    float u, v;
+    float alpha;
+};
+
 /**
  *  TODO:
  *   - avoid constant state switching
@@ -17,10 +25,15 @@
 class Renderer
 {
 public:
+    // Without a window there is no GL context, every GPU resource is skipped and draw calls must not be made
     Renderer(const Window &window_);
 
+    // Returns zero ids without GL context
     static std::vector<unsigned int> surfacesToTexture(const std::vector<SDL_Surface*> &surfaces);
 
+    // False for null renderer, GPU resources should not be created or freed
+    static bool hasContext() noexcept;
+
     // Switch to provided texture as a target
     void setTarget(const Texture &texture_);
     void resetTarget();
@@ -31,6 +44,9 @@ public:
     void fillRenderer(const Color &col_);
     void updateScreen(const Camera &cam_);
 
+    // Time spent inside buffer swap during the last updateScreen call, includes waiting for vsync
+    uint64_t getLastSwapDuration() const noexcept;
+
     // Line, cross
     void drawRectangle(const Vector2<int> &pos_, const Vector2<int> &size_, const Color& col_);
     void drawRectangle(const Vector2<int> &pos_, const Vector2<int> &size_, const Color& col_, const Camera &cam_);
@@ -61,11 +77,18 @@ public:
 
     void renderTile(unsigned int tex_, const Vector2<int> &pos_, const Vector2<int> &size_, SDL_FlipMode flip_, const Vector2<int> &tilesetPixelsPos_);
 
+    // Same texture at every position of positions_ with a single draw call, positions are top left corners in world coordinates
+    void renderTextureInstanced(unsigned int tex_, const Vector2<float> *positions_, size_t count_, const Vector2<int> &size_, SDL_FlipMode flip_, const Camera &cam_);
+
+    // Triangles from texture tex_ with a single draw call, 6 vertices per quad
+    void renderBatch(unsigned int tex_, const BatchVertex *vertices_, size_t count_);
+
 private:
     void selectTarget(const Framebuffer &fb_, const Vector2<int> &size_);
 
     const Window &m_window;
     SDL_GLContext m_context = nullptr;
+    uint64_t m_lastSwapDuration = 0;
 
     Shader m_rectShader;
     Shader m_screenShader;
@@ -73,12 +96,21 @@ private:
     Shader m_spriteShaderRotate;
     Shader m_spriteOutlinedShader;
     Shader m_spriteShaderFlash;
+    Shader m_spriteInstancedShader;
+    Shader m_batchShader;
     Shader m_tileShader;
     Shader m_circleShader;
 
     unsigned int m_rectVAO = 0;
     unsigned int m_screenVAO = 0;
     unsigned int m_spriteVAO = 0;
+    unsigned int m_spriteInstancedVAO = 0;
+
+    // Per-instance positions, refilled by each instanced draw
+    unsigned int m_instanceVBO = 0;
+
+    unsigned int m_batchVAO = 0;
+    unsigned int m_batchVBO = 0;
 
     // Framebuffer for world entities,
     Framebuffer m_worldFB;
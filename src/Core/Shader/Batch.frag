@@ -0,0 +1,21 @@
+#version 400 core
+in vec2 TexCoords;
+in float AlphaMod;
+out vec4 color;
+
+uniform sampler2D image;
+
+float rand(vec2 co) {
+    return fract(sin(dot(co.xy, vec2(12.9898, 78.233))) * 43758.5453);
+}
+
+// Same dissolve as Sprite.frag, but alpha comes with each vertex
+void main()
+{
+    vec4 originalColor = texture(image, TexCoords);
+
+    if (rand(TexCoords.xy) < AlphaMod)
+        color = originalColor * vec4(1, 1, 1, originalColor.w);
+    else
+        color = vec4(0);
+}
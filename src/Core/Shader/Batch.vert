@@ -0,0 +1,16 @@
+#version 400 core
+layout (location = 0) in vec2 pos;
+layout (location = 1) in vec2 texCoords;
+layout (location = 2) in float alpha;
+
+out vec2 TexCoords;
+out float AlphaMod;
+
+uniform mat4 projection;
+
+void main()
+{
+    TexCoords = texCoords;
+    AlphaMod = alpha;
+    gl_Position = projection * vec4(pos, 0.0, 1.0);
+}
@@ -0,0 +1,16 @@
+#version 400 core
+layout (location = 0) in vec3 idTexCoords;
+layout (location = 1) in vec2 instancePos;
+
+out vec2 TexCoords;
+
+// Corners relative to the instance position, flip is already applied
+uniform vec2 vertices[4];
+uniform vec2 offset;
+uniform mat4 projection;
+
+void main()
+{
+    TexCoords = idTexCoords.yz;
+    gl_Position = projection * vec4(instancePos + offset + vertices[int(idTexCoords.x)], 0.0, 1.0);
+}
@@ -0,0 +1,79 @@
+#include "Simulation.h"
+#include "Logger.hpp"
+#include "Profile.h"
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+    float toMs(uint64_t ns_)
+    {
+        return static_cast<float>(ns_) / 1'000'000.0f;
+    }
+}
+
+void SimulationStats::collect(uint64_t frameTime_)
+{
+    m_frameTimes.add(frameTime_);
+    m_frameTimeSum += frameTime_;
+
+    size_t systemIdx = 0;
+    Profiler::instance().forEachPlace([&](const CallData &place_) {
+        if (systemIdx >= m_systems.size())
+            m_systems.emplace_back().m_name = place_.m_funcName;
+
+        auto &system = m_systems[systemIdx];
+        system.m_times.add(place_.m_timeStat.prevSum());
+        system.m_sum += place_.m_timeStat.prevSum();
+        system.m_calls += static_cast<uint64_t>(place_.m_timeStat.prevCount());
+        systemIdx++;
+    });
+}
+
+void SimulationStats::dump(const std::string &levelName_) const
+{
+    const auto frames = m_frameTimes.count();
+    if (frames == 0)
+    {
+        LOG_WARNING("Simulation of \"{}\" did not run a single frame", levelName_);
+        return;
+    }
+
+    std::string report = std::format("Simulated {} frames of \"{}\" in {}ms, frame avg {}ms, p50 {}ms, p99 {}ms, max {}ms\n",
+        frames, levelName_, toMs(m_frameTimeSum), toMs(m_frameTimeSum / frames),
+        toMs(m_frameTimes.percentile(50.0f)), toMs(m_frameTimes.percentile(99.0f)), toMs(m_frameTimes.max()));
+
+    std::format_to(std::back_inserter(report), "{:<40}{:>12}{:>12}{:>12}{:>12}{:>10}\n", "System", "avg ms", "p50 ms", "p99 ms", "max ms", "calls");
+    for (const auto &system : m_systems)
+    {
+        // System could have been registered in the middle of the run, but averages are per simulated frame
+        std::format_to(std::back_inserter(report), "{:<40}{:>12.4f}{:>12.4f}{:>12.4f}{:>12.4f}{:>10.2f}\n",
+            system.m_name, toMs(system.m_sum / frames), toMs(system.m_times.percentile(50.0f)), toMs(system.m_times.percentile(99.0f)),
+            toMs(system.m_times.max()), static_cast<float>(system.m_calls) / static_cast<float>(frames));
+    }
+
+    LOG_INFO("{}", report);
+}
+
+void SimulationStats::save(const std::string &path_) const
+{
+    std::ofstream out(path_);
+    if (!out.is_open())
+        throw std::runtime_error(std::format("Failed to open \"{}\" to save simulation timings", path_));
+
+    const auto frames = std::max<uint64_t>(m_frameTimes.count(), 1);
+
+    out << "system,avg_ns,p50_ns,p99_ns,max_ns,calls_per_frame\n";
+    std::format_to(std::ostreambuf_iterator<char>(out), "frame,{},{},{},{},1\n",
+        m_frameTimeSum / frames, m_frameTimes.percentile(50.0f), m_frameTimes.percentile(99.0f), m_frameTimes.max());
+
+    for (const auto &system : m_systems)
+    {
+        std::format_to(std::ostreambuf_iterator<char>(out), "\"{}\",{},{},{},{},{}\n",
+            system.m_name, system.m_sum / frames, system.m_times.percentile(50.0f), system.m_times.percentile(99.0f),
+            system.m_times.max(), static_cast<float>(system.m_calls) / static_cast<float>(frames));
+    }
+}
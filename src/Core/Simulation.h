@@ -0,0 +1,47 @@
+#pragma once
+#include "FrameTelemetry.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct SimulationConfig
+{
+    // Empty name means the first created level, ignored when replaying since recording knows its level
+    std::string m_level;
+    uint32_t m_frames = 0;
+
+    // Optional InputRecording used as scripted input, simulation stops early when it runs out
+    std::string m_replay;
+
+    // Optional CSV file for per-system timings
+    std::string m_output;
+};
+
+/*
+    Per-system timings of a headless simulation run
+    Systems are places registered in Profiler, so without DUMP_PROFILE only PROFILE_SYSTEM scopes are reported
+    Their statistics roll over in Profiler::cleanFrame() in every build
+*/
+class SimulationStats
+{
+public:
+    // Should be called right after Profiler::cleanFrame(), takes statistics of the frame that just ended
+    void collect(uint64_t frameTime_);
+
+    void dump(const std::string &levelName_) const;
+    void save(const std::string &path_) const;
+
+private:
+    struct SystemTimings
+    {
+        std::string_view m_name;
+        FrameHistogram m_times;
+        uint64_t m_sum = 0;
+        uint64_t m_calls = 0;
+    };
+
+    FrameHistogram m_frameTimes;
+    uint64_t m_frameTimeSum = 0;
+    std::vector<SystemTimings> m_systems;
+};
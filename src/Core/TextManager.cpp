@@ -3,12 +3,129 @@
 #include "FilesystemUtils.h"
 #include "Logger.hpp"  // IWYU pragma: keep
 #include "SDLWrappers.h"
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <format>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    std::unique_ptr<fonts::SymbolGenerator> makeSimpleGenerator(const std::string &file_, uint8_t size_, const Color &color_)
+    {
+        if (!Renderer::hasContext())
+            return std::make_unique<SymbolGeneratorMetrics>(file_, size_);
+
+        return std::make_unique<SymbolGeneratorSimple>(file_, size_, color_);
+    }
+
+    std::unique_ptr<fonts::SymbolGenerator> makeShadedGenerator(Renderer &renderer_, const std::string &file_, uint8_t size_, const Color &shadeColor_, const Color &primaryColor_)
+    {
+        if (!Renderer::hasContext())
+            return std::make_unique<SymbolGeneratorMetrics>(file_, size_);
+
+        return std::make_unique<SymbolGeneratorShaded>(renderer_, file_, size_, shadeColor_, primaryColor_);
+    }
+}
 
 namespace fonts
 {
-    Font::Font(size_t chunkSize_, std::unique_ptr<SymbolGenerator> &&generator_) :
+    GlyphAtlas::GlyphAtlas(Renderer &renderer_) :
+        m_renderer{renderer_}
+    {}
+
+    void GlyphAtlas::addChunk(Chunk &chunk_)
+    {
+        if (!Renderer::hasContext())
+            return;
+
+        constexpr auto noPage = std::numeric_limits<size_t>::max();
+        size_t currentPage = noPage;
+        for (auto &sym : chunk_)
+        {
+            if (!sym.m_id)
+                continue;
+
+            // A new page resets the render target after clearing itself, so it has to be bound again
+            const auto pageCount = m_pages.size();
+            const auto [pageId, pos] = allocate(sym.m_size);
+            const auto &page = m_pages[pageId];
+            if (pageId != currentPage || m_pages.size() != pageCount)
+            {
+                m_renderer.setTarget(page.m_texture);
+                currentPage = pageId;
+            }
+
+            // Rendering into a texture flips it vertically, same as in SymbolGeneratorShaded
+            m_renderer.renderTexture(sym.m_id, {pos.x, PAGE_SIZE - pos.y - sym.m_size.y}, sym.m_size, SDL_FLIP_VERTICAL, 1.0f);
+
+            sym.m_atlasTexture = page.m_texture.handler();
+            sym.m_atlasPos = pos;
+        }
+
+        if (currentPage != noPage)
+            m_renderer.resetTarget();
+    }
+
+    std::pair<size_t, Vector2<int>> GlyphAtlas::allocate(const Vector2<int> &size_)
+    {
+        // Gap between glyphs so neighbours never bleed into each other
+        const auto size = size_ + Vector2{1, 1};
+        if (size.x > PAGE_SIZE || size.y > PAGE_SIZE)
+            throw std::runtime_error(std::format("Glyph of size {} does not fit into {}x{} atlas page", size_, PAGE_SIZE, PAGE_SIZE));
+
+        Shelf *bestShelf = nullptr;
+        size_t bestPage = 0;
+        for (size_t i = 0; i < m_pages.size(); ++i)
+        {
+            for (auto &shelf : m_pages[i].m_shelves)
+            {
+                if (shelf.m_height < size.y || shelf.m_width + size.x > PAGE_SIZE)
+                    continue;
+
+                if (!bestShelf || shelf.m_height < bestShelf->m_height)
+                {
+                    bestShelf = &shelf;
+                    bestPage = i;
+                }
+            }
+        }
+
+        if (!bestShelf)
+        {
+            if (m_pages.empty() || m_pages.back().m_height + size.y > PAGE_SIZE)
+                addPage();
+
+            bestPage = m_pages.size() - 1;
+            auto &page = m_pages.back();
+            bestShelf = &page.m_shelves.emplace_back(Shelf{page.m_height, size.y, 0});
+            page.m_height += size.y;
+        }
+
+        const Vector2<int> pos{bestShelf->m_width, bestShelf->m_y};
+        bestShelf->m_width += size.x;
+
+        return {bestPage, pos};
+    }
+
+    GlyphAtlas::Page &GlyphAtlas::addPage()
+    {
+        auto &page = m_pages.emplace_back();
+        page.m_texture.init(Texture::Config{Vector2{PAGE_SIZE, PAGE_SIZE}});
+
+        // Texture is created without data
+        m_renderer.setTarget(page.m_texture);
+        m_renderer.fillRenderer(Color{0, 0, 0, 0});
+        m_renderer.resetTarget();
+
+        return page;
+    }
+
+    Font::Font(size_t chunkSize_, std::unique_ptr<SymbolGenerator> &&generator_, Renderer &renderer_) :
         m_chunkSize{chunkSize_},
-        m_generator{std::move(generator_)}
+        m_generator{std::move(generator_)},
+        m_atlas{renderer_}
     {
         if (!m_generator)
             throw std::runtime_error("Created generator is nullptr");
@@ -40,6 +157,7 @@ namespace fonts
         auto res = m_chunks.emplace(chunk, Chunk(m_chunkSize));
         assert(res.second);
         m_generator->fillChunk(res.first->second, chunk * m_chunkSize);
+        m_atlas.addChunk(res.first->second);
         return res.first->second.at(loc);
     }
 }
@@ -75,31 +193,42 @@ namespace TextAligners
         return pos_;
     }
 
+    int AlignerLeft::getOffset(int) noexcept
+    {
+        return 0;
+    }
+
     AlignerCenter::AlignerCenter(const U8Wrapper &wrp_, fonts::Font &font_) noexcept :
         CommonAligner{wrp_, font_}
     {}
 
     Vector2<int> AlignerCenter::adjustPos(Vector2<int> pos_) const noexcept
     {
-        const auto len = collectLength();
-
-        pos_.x -= len / 2;
+        pos_.x += getOffset(collectLength());
 
         return pos_;
     }
 
+    int AlignerCenter::getOffset(int length_) noexcept
+    {
+        return -length_ / 2;
+    }
+
     AlignerRight::AlignerRight(const U8Wrapper &wrp_, fonts::Font &font_) noexcept :
         CommonAligner{wrp_, font_}
     {}
 
     Vector2<int> AlignerRight::adjustPos(Vector2<int> pos_) const noexcept
     {
-        const auto len = collectLength();
-
-        pos_.x -= len;
+        pos_.x += getOffset(collectLength());
 
         return pos_;
     }
+
+    int AlignerRight::getOffset(int length_) noexcept
+    {
+        return -length_;
+    }
 }
 
 
@@ -195,15 +324,263 @@ void SymbolGeneratorShaded::fillChunk(fonts::Chunk &chunk_, uint32_t firstChar_)
 }
 
 
+SymbolGeneratorMetrics::SymbolGeneratorMetrics(const std::string &file_, uint8_t size_) :
+    fonts::SymbolGenerator(size_),
+    m_font{file_.c_str(), static_cast<float>(size_)}
+{}
+
+void SymbolGeneratorMetrics::fillChunk(fonts::Chunk &chunk_, uint32_t firstChar_)
+{
+    const auto fontHeight = TTF_GetFontHeight(m_font);
+
+    for (uint32_t i = 0; i < chunk_.size(); ++i)
+    {
+        auto &toFill = chunk_.at(i);
+
+        const uint32_t chid_8 = firstChar_ + i;
+        const uint32_t chid = utf8::u8tou32(chid_8, utf8::readCharSize(chid_8));
+
+        if (!TTF_FontHasGlyph(m_font, chid))
+            continue;
+
+        TTF_GetGlyphMetrics(m_font, chid, &toFill.m_minx, &toFill.m_maxx, &toFill.m_miny, &toFill.m_maxy, &toFill.m_advance);
+
+        // Rendered glyphs are as wide as their advance and as high as the font
+        toFill.m_size = {toFill.m_advance, fontHeight};
+    }
+}
+
+
+void TextLayout::clear() noexcept
+{
+    m_symbols.clear();
+    m_offsets.clear();
+    m_width = 0;
+}
+
+
+TextLayoutCache::TextLayoutCache()
+{
+    m_entries.reserve(CAPACITY);
+    m_lookup.reserve(CAPACITY);
+}
+
+const TextLayout *TextLayoutCache::find(const std::string &text_, Fonts font_)
+{
+    const auto found = m_lookup.find(Key{text_, font_});
+    if (found == m_lookup.end())
+        return nullptr;
+
+    const auto entry = found->second;
+    if (entry != m_head)
+    {
+        unlink(entry);
+        pushFront(entry);
+    }
+
+    return &m_entries[entry].m_layout;
+}
+
+TextLayout &TextLayoutCache::insert(const std::string &text_, Fonts font_)
+{
+    uint32_t entry = INVALID;
+    if (m_entries.size() < CAPACITY)
+    {
+        entry = static_cast<uint32_t>(m_entries.size());
+        m_entries.emplace_back();
+    }
+    else
+    {
+        entry = m_tail;
+        unlink(entry);
+        m_lookup.erase(Key{m_entries[entry].m_text, m_entries[entry].m_font});
+    }
+
+    auto &el = m_entries[entry];
+    el.m_text = text_;
+    el.m_font = font_;
+    el.m_layout.clear();
+
+    m_lookup[Key{el.m_text, font_}] = entry;
+    pushFront(entry);
+
+    return el.m_layout;
+}
+
+size_t TextLayoutCache::size() const noexcept
+{
+    return m_entries.size();
+}
+
+size_t TextLayoutCache::KeyHash::operator()(const Key &key_) const noexcept
+{
+    return std::hash<std::string_view>{}(key_.m_text) ^ (static_cast<size_t>(key_.m_font) * 0x9E3779B97F4A7C15ull);
+}
+
+void TextLayoutCache::unlink(uint32_t entry_)
+{
+    auto &el = m_entries[entry_];
+
+    if (el.m_prev != INVALID)
+        m_entries[el.m_prev].m_next = el.m_next;
+    else
+        m_head = el.m_next;
+
+    if (el.m_next != INVALID)
+        m_entries[el.m_next].m_prev = el.m_prev;
+    else
+        m_tail = el.m_prev;
+
+    el.m_prev = INVALID;
+    el.m_next = INVALID;
+}
+
+void TextLayoutCache::pushFront(uint32_t entry_)
+{
+    auto &el = m_entries[entry_];
+    el.m_prev = INVALID;
+    el.m_next = m_head;
+
+    if (m_head != INVALID)
+        m_entries[m_head].m_prev = entry_;
+    else
+        m_tail = entry_;
+
+    m_head = entry_;
+}
+
+
 TextManager::TextManager(Renderer &renderer_) :
     m_renderer(renderer_),
-    m_fonts{fonts::Font{256, std::make_unique<SymbolGeneratorShaded>(renderer_, Filesystem::getRootDirectory() + "/Resources/Fonts/Silkscreen.ttf", 32, Color{100, 100, 100, 255}, Color{255, 255, 255, 255})}, // Screen debug data
-    fonts::Font{256, std::make_unique<SymbolGeneratorSimple>(Filesystem::getRootDirectory() + "/Resources/Fonts/Silkscreen.ttf", 10, gamedata::colors::LVL1)}, // For npc debug
-    fonts::Font{256, std::make_unique<SymbolGeneratorSimple>(Filesystem::getRootDirectory() + "/Resources/Fonts/Silkscreen.ttf", 8, Color{255, 255, 255, 255})}, // For navigation system
-    fonts::Font{64, std::make_unique<SymbolGeneratorSimple>(Filesystem::getRootDirectory() + "/Resources/Fonts/Silkscreen.ttf", 16, gamedata::colors::LVL1)}} // Used for chatbox
+    m_fonts{fonts::Font{256, makeShadedGenerator(renderer_, Filesystem::getRootDirectory() + "/Resources/Fonts/Silkscreen.ttf", 32, Color{100, 100, 100, 255}, Color{255, 255, 255, 255}), renderer_}, // Screen debug data
+    fonts::Font{256, makeSimpleGenerator(Filesystem::getRootDirectory() + "/Resources/Fonts/Silkscreen.ttf", 10, gamedata::colors::LVL1), renderer_}, // For npc debug
+    fonts::Font{256, makeSimpleGenerator(Filesystem::getRootDirectory() + "/Resources/Fonts/Silkscreen.ttf", 8, Color{255, 255, 255, 255}), renderer_}, // For navigation system
+    fonts::Font{64, makeSimpleGenerator(Filesystem::getRootDirectory() + "/Resources/Fonts/Silkscreen.ttf", 16, gamedata::colors::LVL1), renderer_}} // Used for chatbox
 {
 }
 
+void TextManager::renderSymbol(const fonts::Symbol &symbol_, const Vector2<int> &pos_, float alpha_)
+{
+    addQuad(symbol_, pos_, alpha_);
+
+    if (m_batchDepth == 0)
+        flush();
+}
+
+void TextManager::beginBatch() noexcept
+{
+    m_batchDepth++;
+}
+
+void TextManager::endBatch()
+{
+    assert(m_batchDepth > 0);
+
+    if (--m_batchDepth == 0)
+        flush();
+}
+
+const TextLayout &TextManager::getLayout(const std::string &text_, Fonts font_)
+{
+    if (const auto *found = m_layouts.find(text_, font_))
+        return *found;
+
+    auto &font = getFont(font_);
+    auto &layout = m_layouts.insert(text_, font_);
+    for (auto &ch : U8Wrapper(text_))
+    {
+        const auto &sym = font[ch.getu8()];
+        if (layout.m_symbols.empty())
+            layout.m_width = sym.m_minx;
+
+        layout.m_symbols.push_back(&sym);
+        layout.m_offsets.push_back(layout.m_width);
+        layout.m_width += sym.m_advance;
+    }
+
+    return layout;
+}
+
+const TextLayout &TextManager::getNumberLayout(int64_t value_, Fonts font_)
+{
+    auto &digits = m_digits[static_cast<size_t>(font_)];
+    if (!digits[0])
+    {
+        auto &font = getFont(font_);
+        for (uint32_t i = 0; i < 10; ++i)
+            digits[i] = &font['0' + i];
+
+        digits[10] = &font['-'];
+    }
+
+    // Enough for any int64_t
+    std::array<char, 20> buffer;
+    const auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value_);
+    assert(ec == std::errc{});
+
+    m_numberLayout.clear();
+    for (auto *ch = buffer.data(); ch != end; ++ch)
+    {
+        const auto *sym = (*ch == '-' ? digits[10] : digits[*ch - '0']);
+        if (m_numberLayout.m_symbols.empty())
+            m_numberLayout.m_width = sym->m_minx;
+
+        m_numberLayout.m_symbols.push_back(sym);
+        m_numberLayout.m_offsets.push_back(m_numberLayout.m_width);
+        m_numberLayout.m_width += sym->m_advance;
+    }
+
+    return m_numberLayout;
+}
+
+void TextManager::addLayout(const TextLayout &layout_, const Vector2<int> &pos_)
+{
+    for (size_t i = 0; i < layout_.m_symbols.size(); ++i)
+        addQuad(*layout_.m_symbols[i], {pos_.x + layout_.m_offsets[i], pos_.y}, 1.0f);
+}
+
+void TextManager::addQuad(const fonts::Symbol &symbol_, const Vector2<int> &pos_, float alpha_)
+{
+    if (!symbol_.m_atlasTexture)
+        return;
+
+    auto batch = std::find_if(m_batches.begin(), m_batches.end(), [&symbol_](const TextBatch &batch_) {
+        return batch_.m_texture == symbol_.m_atlasTexture;
+    });
+
+    if (batch == m_batches.end())
+        batch = m_batches.insert(m_batches.end(), TextBatch{symbol_.m_atlasTexture, {}});
+
+    constexpr float pageSize = fonts::GlyphAtlas::PAGE_SIZE;
+    const float lft = static_cast<float>(pos_.x);
+    const float top = static_cast<float>(pos_.y);
+    const float rgt = lft + static_cast<float>(symbol_.m_size.x);
+    const float bot = top + static_cast<float>(symbol_.m_size.y);
+    const float u0 = static_cast<float>(symbol_.m_atlasPos.x) / pageSize;
+    const float v0 = static_cast<float>(symbol_.m_atlasPos.y) / pageSize;
+    const float u1 = static_cast<float>(symbol_.m_atlasPos.x + symbol_.m_size.x) / pageSize;
+    const float v1 = static_cast<float>(symbol_.m_atlasPos.y + symbol_.m_size.y) / pageSize;
+
+    // Same vertex order as sprite quad: TL, TR, BR, BL, TL, BR
+    batch->m_vertices.insert(batch->m_vertices.end(), {
+        BatchVertex{lft, top, u0, v0, alpha_},
+        BatchVertex{rgt, top, u1, v0, alpha_},
+        BatchVertex{rgt, bot, u1, v1, alpha_},
+        BatchVertex{lft, bot, u0, v1, alpha_},
+        BatchVertex{lft, top, u0, v0, alpha_},
+        BatchVertex{rgt, bot, u1, v1, alpha_}
+    });
+}
+
+void TextManager::flush()
+{
+    for (auto &batch : m_batches)
+    {
+        m_renderer.renderBatch(batch.m_texture, batch.m_vertices.data(), batch.m_vertices.size());
+        batch.m_vertices.clear();
+    }
+}
+
 fonts::Font &TextManager::getFont(Fonts font_)
 {
     return m_fonts.at(static_cast<size_t>(font_));
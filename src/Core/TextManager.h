@@ -6,6 +6,10 @@
 #include <SDL3_ttf/SDL_ttf.h>
 #include <vector>
 #include <array>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
 namespace fonts
 {
@@ -15,10 +19,53 @@ namespace fonts
         unsigned int m_id = 0;
         Vector2<int> m_size;
         int m_minx = 0, m_maxx = 0, m_miny = 0, m_maxy = 0, m_advance = 0;
+
+        // Page of the font atlas with a copy of m_id and the top left corner of the copy, 0 if glyph is not in atlas
+        unsigned int m_atlasTexture = 0;
+        Vector2<int> m_atlasPos;
     };
 
     using Chunk = std::vector<Symbol>;
 
+    /*
+        All glyphs of a font copied into a few big textures, so a whole string can be drawn with a single texture
+        Glyphs are placed with shelf packing: a glyph goes to the shelf with the least wasted height that still has space,
+            new shelves and pages are added only when nothing fits
+        Chunks are added as they are generated, already placed glyphs never move
+    */
+    class GlyphAtlas
+    {
+    public:
+        static constexpr int PAGE_SIZE = 512;
+
+        GlyphAtlas(Renderer &renderer_);
+
+        // Copies every glyph of the chunk into the atlas and fills its atlas data, does nothing without GL context
+        void addChunk(Chunk &chunk_);
+
+    private:
+        struct Shelf
+        {
+            int m_y;
+            int m_height;
+            int m_width;
+        };
+
+        struct Page
+        {
+            Texture m_texture;
+            std::vector<Shelf> m_shelves;
+            int m_height = 0;
+        };
+
+        // Finds space for a glyph, creating a shelf or a page if necessary
+        std::pair<size_t, Vector2<int>> allocate(const Vector2<int> &size_);
+        Page &addPage();
+
+        Renderer &m_renderer;
+        std::vector<Page> m_pages;
+    };
+
     class SymbolGenerator
     {
     public:
@@ -34,7 +81,7 @@ namespace fonts
     class Font
     {
     public:
-        Font(size_t chunkSize_, std::unique_ptr<SymbolGenerator> &&generator_);
+        Font(size_t chunkSize_, std::unique_ptr<SymbolGenerator> &&generator_, Renderer &renderer_);
         uint8_t height() const noexcept;
         const Symbol &operator[](uint32_t char_);
 
@@ -42,6 +89,7 @@ namespace fonts
         const size_t m_chunkSize;
         std::unordered_map<uint32_t, std::vector<Symbol>> m_chunks;
         const std::unique_ptr<SymbolGenerator> m_generator;
+        GlyphAtlas m_atlas;
     };
 }
 
@@ -62,11 +110,13 @@ namespace TextAligners
         fonts::Font &m_font;
     };
 
+    // getOffset is the horizontal shift of a string with already known length, doesn't require another pass over it
     class AlignerLeft : public CommonAligner
     {
     public:
         AlignerLeft(const U8Wrapper &wrp_, fonts::Font &font_) noexcept;
         Vector2<int> adjustPos(Vector2<int> pos_) const noexcept override;
+        static int getOffset(int length_) noexcept;
     };
 
     class AlignerCenter : public CommonAligner
@@ -74,6 +124,7 @@ namespace TextAligners
     public:
         AlignerCenter(const U8Wrapper &wrp_, fonts::Font &font_) noexcept;
         Vector2<int> adjustPos(Vector2<int> pos_) const noexcept override;
+        static int getOffset(int length_) noexcept;
     };
 
     class AlignerRight : public CommonAligner
@@ -81,6 +132,7 @@ namespace TextAligners
     public:
         AlignerRight(const U8Wrapper &wrp_, fonts::Font &font_) noexcept;
         Vector2<int> adjustPos(Vector2<int> pos_) const noexcept override;
+        static int getOffset(int length_) noexcept;
     };
 } // TextAligners
 
@@ -109,6 +161,17 @@ private:
     Renderer &m_renderer;
 };
 
+// Null text generator for headless runs, symbols only have metrics and no textures
+class SymbolGeneratorMetrics : public fonts::SymbolGenerator
+{
+public:
+    SymbolGeneratorMetrics(const std::string &file_, uint8_t size_);
+    void fillChunk(fonts::Chunk &chunk_, uint32_t firstChar_) override;
+
+private:
+    FontWrapper m_font;
+};
+
 
 enum class Fonts : uint8_t
 {
@@ -120,12 +183,81 @@ enum class Fonts : uint8_t
 };
 
 
+// String decoded into symbols and measured, offsets are relative to the left edge of the string
+struct TextLayout
+{
+    std::vector<const fonts::Symbol*> m_symbols;
+    std::vector<int> m_offsets;
+    int m_width = 0;
+
+    void clear() noexcept;
+};
+
+/*
+    Layouts of recently drawn strings, so labels that stay the same between frames are decoded and measured only once
+    Holds up to CAPACITY layouts, the least recently used one is replaced when it's full
+    Alignment only shifts the whole layout by a function of its width, so it's applied when drawing and is not a part of the key
+*/
+class TextLayoutCache
+{
+public:
+    static constexpr size_t CAPACITY = 512;
+
+    TextLayoutCache();
+
+    // nullptr if not cached, found layout becomes the most recently used
+    const TextLayout *find(const std::string &text_, Fonts font_);
+
+    // Empty layout for the string to fill, replaces the least recently used one if cache is full
+    TextLayout &insert(const std::string &text_, Fonts font_);
+
+    size_t size() const noexcept;
+
+private:
+    static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+    // Views into text of the entry that owns the key
+    struct Key
+    {
+        std::string_view m_text;
+        Fonts m_font;
+
+        bool operator==(const Key &rhs_) const noexcept = default;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key &key_) const noexcept;
+    };
+
+    // Entries are an intrusive list from the most to the least recently used
+    struct Entry
+    {
+        std::string m_text;
+        Fonts m_font = Fonts::NONE;
+        TextLayout m_layout;
+        uint32_t m_prev = INVALID;
+        uint32_t m_next = INVALID;
+    };
+
+    void unlink(uint32_t entry_);
+    void pushFront(uint32_t entry_);
+
+    // Never grows past CAPACITY, so keys pointing into entries stay valid
+    std::vector<Entry> m_entries;
+    std::unordered_map<Key, uint32_t, KeyHash> m_lookup;
+    uint32_t m_head = INVALID;
+    uint32_t m_tail = INVALID;
+};
+
+
 class TextManager
 {
 private:
     using FontsContainer = std::array<fonts::Font, static_cast<size_t>(Fonts::NONE)>;
 
 public:
+    // Fonts only provide metrics if renderer has no context
     TextManager(Renderer &renderer_);
 
     // Ignores '\n', '\t'
@@ -136,9 +268,51 @@ public:
     template<typename AlignerT>
     void renderText(const std::string &text_, Fonts font_, Vector2<int> pos_);
 
+    // Digits only, skips string formatting and symbol lookup
+    template<typename AlignerT>
+    void renderNumber(int64_t value_, Fonts font_, Vector2<int> pos_, const Camera &cam_);
+
+    template<typename AlignerT>
+    void renderNumber(int64_t value_, Fonts font_, Vector2<int> pos_);
+
+    // Single symbol from the font atlas, alpha_ works the same way as in Renderer::renderTexture
+    void renderSymbol(const fonts::Symbol &symbol_, const Vector2<int> &pos_, float alpha_);
+
+    /*
+        Text rendered between beginBatch and endBatch is collected and drawn in endBatch with one draw call per atlas page
+        Outside of a batch text is drawn right away, still with one draw call per string
+        Batches can be nested, only the outermost endBatch draws
+    */
+    void beginBatch() noexcept;
+    void endBatch();
+
     fonts::Font &getFont(Fonts font_);
 
 private:
+    struct TextBatch
+    {
+        unsigned int m_texture;
+        std::vector<BatchVertex> m_vertices;
+    };
+
+    // Cached layout of the string, decoded and measured in a single pass on a miss
+    const TextLayout &getLayout(const std::string &text_, Fonts font_);
+    const TextLayout &getNumberLayout(int64_t value_, Fonts font_);
+    void addLayout(const TextLayout &layout_, const Vector2<int> &pos_);
+    void addQuad(const fonts::Symbol &symbol_, const Vector2<int> &pos_, float alpha_);
+    void flush();
+
     Renderer &m_renderer;
     FontsContainer m_fonts;
+
+    TextLayoutCache m_layouts;
+
+    // '0' - '9' and '-' of each font, filled on the first number
+    std::array<std::array<const fonts::Symbol*, 11>, static_cast<size_t>(Fonts::NONE)> m_digits = {};
+
+    // Scratch buffers, kept to avoid allocations
+    TextLayout m_numberLayout;
+    std::vector<TextBatch> m_batches;
+
+    int m_batchDepth = 0;
 };
@@ -1,38 +1,39 @@
 #pragma once
 #include "TextManager.h"
+#include "GameData.h"
 
 template<typename AlignerT>
 void TextManager::renderText(const std::string &text_, Fonts font_, Vector2<int> pos_, const Camera &cam_)
 {
-    U8Wrapper wrp(text_);
-    auto &font = getFont(font_);
-    AlignerT aligner{wrp, font};
-
-    pos_ = aligner.adjustPos(pos_);
-    pos_.x += font[wrp.begin().getu8()].m_minx;
-    
-    for (auto &ch : wrp)
-    {
-        const auto &sym = font[ch.getu8()];
-        m_renderer.renderTexture(sym.m_id, pos_, sym.m_size, SDL_FLIP_NONE, 1.0f, cam_);
-        pos_.x += sym.m_advance;
-    }
+    const auto camTL = Vector2<int>(cam_.getPos() - gamedata::global::maxCameraSize / 2.0f);
+    renderText<AlignerT>(text_, font_, pos_ - camTL);
 }
 
 template<typename AlignerT>
 void TextManager::renderText(const std::string &text_, Fonts font_, Vector2<int> pos_)
 {
-    U8Wrapper wrp(text_);
-    auto &font = getFont(font_);
-    AlignerT aligner{wrp, font};
+    const auto &layout = getLayout(text_, font_);
+    pos_.x += AlignerT::getOffset(layout.m_width);
+    addLayout(layout, pos_);
+
+    if (m_batchDepth == 0)
+        flush();
+}
 
-    pos_ = aligner.adjustPos(pos_);
-    pos_.x += font[wrp.begin().getu8()].m_minx;
+template<typename AlignerT>
+void TextManager::renderNumber(int64_t value_, Fonts font_, Vector2<int> pos_, const Camera &cam_)
+{
+    const auto camTL = Vector2<int>(cam_.getPos() - gamedata::global::maxCameraSize / 2.0f);
+    renderNumber<AlignerT>(value_, font_, pos_ - camTL);
+}
+
+template<typename AlignerT>
+void TextManager::renderNumber(int64_t value_, Fonts font_, Vector2<int> pos_)
+{
+    const auto &layout = getNumberLayout(value_, font_);
+    pos_.x += AlignerT::getOffset(layout.m_width);
+    addLayout(layout, pos_);
 
-    for (auto &ch : wrp)
-    {
-        const auto &sym = font[ch.getu8()];
-        m_renderer.renderTexture(sym.m_id, pos_, sym.m_size, SDL_FLIP_NONE, 1.0f);
-        pos_.x += sym.m_advance;
-    }
+    if (m_batchDepth == 0)
+        flush();
 }
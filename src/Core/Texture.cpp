@@ -1,4 +1,5 @@
 #include "Texture.h"
+#include "Renderer.h"
 #include "glad/glad.h"
 
 Texture::Config::Config(const Vector2<int> &size_) :
@@ -27,6 +28,10 @@ void Texture::init(const Config &cfg_)
 {
     m_size = cfg_.m_size;
 
+    // Headless run, only size is kept
+    if (!Renderer::hasContext())
+        return;
+
     if (!m_id)
     {
         glGenTextures(1, &m_id);
@@ -1,6 +1,9 @@
 #pragma once
+#include <algorithm>
 #include <stdexcept>
+#include <cstdint>
 #include <map>
+#include <type_traits>
 #include <vector>
 #include <format>
 
@@ -19,14 +22,39 @@
         5 - "five"
         6 - "five"
     For a move-only structs, use addPair
-    Mostly designed to map properties to frames, has internal optimization
-        for sequential access in both directions
-        like 1 - 2 - 3 - ...
-    Isn't exception-safe or thread-safe
+    Mostly designed to map properties to frames
+    operator[] is a plain binary search that doesn't touch internal state, so concurrent reads are safe
+    For sequential access in both directions (like 1 - 2 - 3 - ...), use get with a caller-owned Cursor -
+        it remembers the last position and walks from it
+    Timelines with all keys below m_bakeThreshold are baked into a dense frame => value index table (a bitset for bool),
+        lookups then are just a clamp and an indexing
+    Isn't exception-safe
 */
 template<typename T>
 class TimelineProperty {
 public:
+    // bool can be baked into a bitset, so it cannot be returned by reference
+    using ReturnT = std::conditional_t<std::is_same_v<T, bool>, bool, const T&>;
+
+    /*
+        Caller-owned lookup position, should be kept per entity / per iteration
+        Only affects lookup speed, never the result, so it can be safely reused with another timeline
+    */
+    class Cursor
+    {
+    public:
+        Cursor() = default;
+
+        void reset() noexcept
+        {
+            m_idx = 0;
+        }
+
+    private:
+        friend class TimelineProperty<T>;
+        size_t m_idx = 0;
+    };
+
     // Requires copying due to std::map - inevitable because for nice syntax you need to build std::initializer_list
     TimelineProperty(const std::map<uint32_t, T> &values_)
     {
@@ -38,19 +66,21 @@ public:
         for (const auto &el : values_)
             m_data.emplace_back(el);
 
-        m_lastRequest = m_data.end();
+        bake();
     }
 
     // Creates at 0, requires only move-constructor
     TimelineProperty(T &&rhs_) :
-        m_data{{0, std::move(rhs_)}},
-        m_lastRequest{m_data.begin()}
-    {}
+        m_data{{0, std::move(rhs_)}}
+    {
+        bake();
+    }
 
     TimelineProperty(const T &rhs_) :
-        m_data{{0, rhs_}},
-        m_lastRequest{m_data.begin()}
-    {}
+        m_data{{0, rhs_}}
+    {
+        bake();
+    }
 
     TimelineProperty() = default;
 
@@ -58,18 +88,10 @@ public:
     TimelineProperty& operator=(const TimelineProperty<T> &rhs_) = delete;
 
     // Requires only move constructor
-    TimelineProperty(TimelineProperty<T> &&rhs_) noexcept :
-        m_data{std::move(rhs_.m_data)},
-        m_lastRequest{m_data.begin()}
-    {}
+    TimelineProperty(TimelineProperty<T> &&rhs_) noexcept = default;
 
     // Requires only move constructor
-    TimelineProperty& operator=(TimelineProperty<T> &&rhs_) noexcept
-    {
-        m_data = std::move(rhs_.m_data);
-        m_lastRequest = m_data.begin();
-        return *this;
-    }
+    TimelineProperty& operator=(TimelineProperty<T> &&rhs_) noexcept = default;
 
     bool isEmpty() const noexcept
     {
@@ -87,7 +109,7 @@ public:
                 m_data.emplace(m_data.begin(), timeMark_, std::move(rhs_));
             else
             {
-                const auto it = binarySearch(timeMark_);
+                const auto it = m_data.begin() + binarySearch(timeMark_);
                 if (it->first == timeMark_)
                     it->second = std::move(rhs_);
                 else
@@ -95,7 +117,7 @@ public:
             }
         }
 
-        m_lastRequest = m_data.begin();
+        bake();
         return *this;
     }
 
@@ -110,7 +132,7 @@ public:
                 m_data.emplace(m_data.begin(), timeMark_, rhs_);
             else
             {
-                const auto it = binarySearch(timeMark_);
+                const auto it = m_data.begin() + binarySearch(timeMark_);
                 if (it->first == timeMark_)
                     it->second = rhs_;
                 else
@@ -118,103 +140,139 @@ public:
             }
         }
 
-        m_lastRequest = m_data.begin();
+        bake();
         return *this;
     }
 
-    const T &operator[](uint32_t timeMark_) const
+    bool isBaked() const noexcept
     {
-        iterateLastTo(timeMark_);
-        return m_lastRequest->second;
+        return m_baked;
     }
 
-protected:
-    void iterateLastTo(uint32_t timeMark_) const
+    ReturnT operator[](uint32_t timeMark_) const
     {
+        if (m_baked)
+            return getBaked(timeMark_);
+
         if (m_data.empty())
             throw std::runtime_error("Trying to index an empty timeline");
 
-        const int64_t diff = static_cast<int64_t>(timeMark_) - m_lastRequest->first;
+        return m_data[binarySearch(timeMark_)].second;
+    }
+
+    // Amortized O(1) for sequential access
+    ReturnT get(uint32_t timeMark_, Cursor &cursor_) const
+    {
+        if (m_baked)
+            return getBaked(timeMark_);
 
-        // Dirty, but only 2 conditions at most in probably the most important function in the project
-        if (diff > 0)
-        {
-            if (diff <= 5)
-            {
-                while (m_lastRequest != m_data.end() - 1 && (m_lastRequest + 1)->first <= timeMark_)
-                    ++m_lastRequest;
-            }
-            else
-                m_lastRequest = binarySearch(timeMark_);
-        }
-        else if (diff < 0)
-        {
-            if (diff >= -5)
-            {
-                while (m_lastRequest != m_data.begin() && m_lastRequest->first > timeMark_)
-                    m_lastRequest--;
-            }
-            else
-                m_lastRequest = binarySearch(timeMark_);
-        }
+        if (m_data.empty())
+            throw std::runtime_error("Trying to index an empty timeline");
+
+        cursor_.m_idx = iterateTo(std::min(cursor_.m_idx, m_data.size() - 1), timeMark_);
+        return m_data[cursor_.m_idx].second;
+    }
+
+protected:
+    // Everything after the last key has the same value, so out-of-range frames are just clamped
+    ReturnT getBaked(uint32_t timeMark_) const noexcept
+    {
+        const auto frame = std::min(timeMark_, m_bakedLastFrame);
+
+        if constexpr (std::is_same_v<T, bool>)
+            return (m_bakedBits[frame >> 6] >> (frame & 63)) & 1;
+        else
+            return m_data[m_bakedIndices[frame]].second;
     }
 
-    std::vector<std::pair<uint32_t, T>>::const_iterator binarySearch(const uint32_t timeMark_) const
+    void bake()
     {
-        const auto size = m_data.size();
-        if (timeMark_ >= m_data[size - 1].first)
-            return m_data.cbegin() + (size - 1);
+        m_baked = false;
+        m_bakedIndices.clear();
+        m_bakedBits.clear();
 
-        if (timeMark_ <= m_data[0].first)
-            return m_data.cbegin();
+        if (m_data.empty() || m_data.back().first >= m_bakeThreshold)
+            return;
 
-        size_t lBound = 0, rBound = size - 2;
+        m_bakedLastFrame = m_data.back().first;
 
-        while (rBound - lBound > 1)
+        if constexpr (std::is_same_v<T, bool>)
+            m_bakedBits.resize(m_bakedLastFrame / 64 + 1, 0);
+        else
+            m_bakedIndices.resize(m_bakedLastFrame + 1);
+
+        size_t idx = 0;
+        for (uint32_t frame = 0; frame <= m_bakedLastFrame; ++frame)
         {
-            size_t idxBetween = (rBound + lBound) / 2;
-            if (timeMark_ >= m_data[idxBetween].first)
-                lBound = idxBetween;
+            while (idx + 1 < m_data.size() && m_data[idx + 1].first <= frame)
+                ++idx;
+
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                if (m_data[idx].second)
+                    m_bakedBits[frame >> 6] |= (uint64_t{1} << (frame & 63));
+            }
             else
-                rBound = idxBetween - 1;
+                m_bakedIndices[frame] = static_cast<uint8_t>(idx);
         }
 
-        if (m_data[rBound].first <= timeMark_)
-            return m_data.cbegin() + rBound;
-
-        return m_data.cbegin() + lBound;
+        m_baked = true;
     }
 
-    std::vector<std::pair<uint32_t, T>>::iterator binarySearch(const uint32_t timeMark_)
+    size_t iterateTo(size_t idx_, uint32_t timeMark_) const
     {
-        const auto size = m_data.size();
-        if (timeMark_ >= m_data[size - 1].first)
-            return m_data.begin() + (size - 1);
-
-        if (timeMark_ <= m_data[0].first)
-            return m_data.begin();
-
-        size_t lBound = 0, rBound = size - 2;
+        const int64_t diff = static_cast<int64_t>(timeMark_) - m_data[idx_].first;
 
-        while (rBound - lBound > 1)
+        // Dirty, but only 2 conditions at most in probably the most important function in the project
+        if (diff > 0)
+        {
+            if (diff <= m_stepThreshold)
+            {
+                while (idx_ != m_data.size() - 1 && m_data[idx_ + 1].first <= timeMark_)
+                    ++idx_;
+            }
+            else
+                idx_ = binarySearch(timeMark_);
+        }
+        else if (diff < 0)
         {
-            size_t idxBetween = (rBound + lBound) / 2;
-            if (timeMark_ >= m_data[idxBetween].first)
-                lBound = idxBetween;
+            if (diff >= -m_stepThreshold)
+            {
+                while (idx_ != 0 && m_data[idx_].first > timeMark_)
+                    idx_--;
+            }
             else
-                rBound = idxBetween - 1;
+                idx_ = binarySearch(timeMark_);
         }
 
-        if (m_data[rBound].first <= timeMark_)
-            return m_data.begin() + rBound;
+        return idx_;
+    }
+
+    // Index of the greatest key <= timeMark_, or the first key if there is none
+    size_t binarySearch(const uint32_t timeMark_) const
+    {
+        const auto it = std::upper_bound(m_data.cbegin(), m_data.cend(), timeMark_, [](uint32_t mark_, const std::pair<uint32_t, T> &el_) {
+            return mark_ < el_.first;
+        });
+
+        if (it == m_data.cbegin())
+            return 0;
 
-        return m_data.begin() + lBound;
+        return static_cast<size_t>(it - m_data.cbegin()) - 1;
     }
 
     std::vector<std::pair<uint32_t, T>> m_data;
-    mutable std::vector<std::pair<uint32_t, T>>::const_iterator m_lastRequest = m_data.end();
+
+    // Baked representation, only one of them is used depending on T
+    bool m_baked = false;
+    uint32_t m_bakedLastFrame = 0;
+    std::vector<uint8_t> m_bakedIndices;
+    std::vector<uint64_t> m_bakedBits;
 
     static constexpr int m_stepThreshold = 5;
+
+    // Keys are guaranteed to be < 256, so uint8_t is enough to index m_data
+    static constexpr uint32_t m_bakeThreshold = 256;
 };
 
 /**
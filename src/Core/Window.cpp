@@ -2,10 +2,12 @@
 #include "Configuration.h"
 #include <stdexcept>
 
-Window::Window(std::string &&winName_) :
+Window::Window(std::string &&winName_, bool headless_) :
     m_winName(std::move(winName_))
 {
     m_resolution = ConfigurationManager::instance().m_settings["video"]["window_resolution"].readOrSet<Vector2<uint16_t>>({1920, 1080});
+    if (headless_)
+        return;
 
     m_window = SDL_CreateWindow(m_winName.c_str(), m_resolution.x, m_resolution.y, SDL_WINDOW_OPENGL);
     if (!m_window)
@@ -30,3 +32,9 @@ SDL_Window* Window::getWindow() const noexcept
     return m_window;
 }
 
+void Window::hide()
+{
+    if (m_window)
+        SDL_HideWindow(m_window);
+}
+
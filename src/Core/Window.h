@@ -6,13 +6,16 @@
 class Window
 {
 public:
-    Window(std::string &&winName_);
+    // Headless window only knows its resolution, getWindow() returns nullptr
+    Window(std::string &&winName_, bool headless_);
     ~Window();
 
     Vector2<uint16_t> getResolution() const noexcept;
 
     SDL_Window* getWindow() const noexcept;
 
+    void hide();
+
 private:
     SDL_Window* m_window = nullptr;
     std::string m_winName;
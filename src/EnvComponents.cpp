@@ -1,11 +1,8 @@
 #include "EnvComponents.h"
-#include "Core/CoreComponents.h"
+#include "Core/PropSet.h"
 
 const Collider GrassTopComp::colliderRight{.m_topLeft=Vector2{14, -6}, .m_size=Vector2{2, 6}};
 const Collider GrassTopComp::colliderLeft{.m_topLeft=Vector2{-14, -6}, .m_size=Vector2{2, 6}};
-ResID GrassTopComp::m_idleAnimId = 0;
-ResID GrassTopComp::m_flickLeftAnimId = 0;
-ResID GrassTopComp::m_flickRightAnimId = 0;
 
 void GrassTopComp::touchedPlayer(const Vector2<float> &velocity_, EntityAnywhere self_)
 {
@@ -13,19 +10,9 @@ void GrassTopComp::touchedPlayer(const Vector2<float> &velocity_, EntityAnywhere
     {
         case State::IDLE:
             if (velocity_.x >= 2.2f)
-            {
-                auto &renderable = self_.reg->get<ComponentAnimationRenderable>(self_.idx);
-                renderable.m_currentAnimation = &renderable.m_animations.at(m_flickRightAnimId);
-                renderable.m_currentAnimation->reset();
-                m_state = State::FLICK_RIGHT;
-            }
+                setState(State::FLICK_RIGHT, self_);
             else if (velocity_.x <= -2.2f)
-            {
-                auto &renderable = self_.reg->get<ComponentAnimationRenderable>(self_.idx);
-                renderable.m_currentAnimation = &renderable.m_animations.at(m_flickLeftAnimId);
-                renderable.m_currentAnimation->reset();
-                m_state = State::FLICK_LEFT;
-            }
+                setState(State::FLICK_LEFT, self_);
             break;
 
         default:
@@ -35,16 +22,14 @@ void GrassTopComp::touchedPlayer(const Vector2<float> &velocity_, EntityAnywhere
 
 bool GrassTopComp::update(EntityAnywhere self_)
 {
-    if (m_state != State::IDLE)
-    {
-        auto &renderable = self_.reg->get<ComponentAnimationRenderable>(self_.idx);
-        if (renderable.m_currentAnimation->isFinished())
-        {
-            renderable.m_currentAnimation = &renderable.m_animations.at(m_idleAnimId);
-            renderable.m_currentAnimation->reset();
-            m_state = State::IDLE;
-        }
-    }
+    if (m_state != State::IDLE && self_.reg->get<PropSet>(m_propSet).isClipFinished(m_instance))
+        setState(State::IDLE, self_);
 
     return m_state == State::IDLE;
 }
+
+void GrassTopComp::setState(State state_, EntityAnywhere self_)
+{
+    self_.reg->get<PropSet>(m_propSet).setClip(m_instance, static_cast<uint8_t>(state_));
+    m_state = state_;
+}
@@ -12,14 +12,19 @@ public:
 
     static const Collider colliderRight;
     static const Collider colliderLeft;
-    static ResID m_idleAnimId;
-    static ResID m_flickLeftAnimId;
-    static ResID m_flickRightAnimId;
 
+    // Also the clip index in the prop set
     enum class State : uint8_t
     {
         IDLE,
         FLICK_LEFT,
         FLICK_RIGHT
     } m_state = State::IDLE;
+
+    // Entity with PropSet that draws this grass
+    entt::entity m_propSet = entt::null;
+    uint32_t m_instance = 0;
+
+private:
+    void setState(State state_, EntityAnywhere self_);
 };
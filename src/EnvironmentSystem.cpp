@@ -1,37 +1,149 @@
 #include "EnvironmentSystem.h"
 #include "EnvComponents.h"
 #include "Core/CoreComponents.h"
+#include "Core/Logger.hpp"
+#include <algorithm>
+#include <limits>
 
 EnvironmentSystem::EnvironmentSystem(entt::registry &reg_) :
     m_reg(reg_)
 {
+    const auto left = GrassTopComp::colliderLeft + Vector2{0, 0};
+    const auto right = GrassTopComp::colliderRight + Vector2{0, 0};
+    const Vector2<int> topLeft{std::min(left.getLeftEdge(), right.getLeftEdge()), std::min(left.getTopEdge(), right.getTopEdge())};
+    const Vector2<int> bottomRight{std::max(left.getRightEdge(), right.getRightEdge()), std::max(left.getBottomEdge(), right.getBottomEdge())};
+    m_grassReach = {topLeft, bottomRight - topLeft + Vector2{1, 1}};
+}
+
+void EnvironmentSystem::buildIndex()
+{
+    m_grass.clear();
+    m_cellStarts.clear();
+    m_activeGrass.clear();
+
+    auto grassTops = m_reg.view<ComponentTransform, GrassTopComp>();
+
+    Vector2<int> minPos{std::numeric_limits<int>::max(), std::numeric_limits<int>::max()};
+    Vector2<int> maxPos{std::numeric_limits<int>::min(), std::numeric_limits<int>::min()};
+    for (const auto &[idx, trans, grass] : grassTops.each())
+    {
+        minPos = {std::min(minPos.x, trans.m_pos.x), std::min(minPos.y, trans.m_pos.y)};
+        maxPos = {std::max(maxPos.x, trans.m_pos.x), std::max(maxPos.y, trans.m_pos.y)};
+        m_grass.push_back({idx, trans.m_pos});
+
+        if (grass.m_state != GrassTopComp::State::IDLE)
+            m_activeGrass.push_back(idx);
+    }
+
+    if (m_grass.empty())
+    {
+        m_gridSize = {0, 0};
+        return;
+    }
+
+    m_gridOrigin = minPos;
+    m_gridSize = (maxPos - minPos) / CELL_SIZE + Vector2{1, 1};
+
+    // Counting sort by cell, tops of the same cell end up next to each other
+    const auto cellId = [&](const GrassEntry &entry_) {
+        const auto cell = getCell(entry_.m_pos);
+        return static_cast<size_t>(cell.y) * m_gridSize.x + cell.x;
+    };
+
+    m_cellStarts.assign(static_cast<size_t>(m_gridSize.x) * m_gridSize.y + 1, 0);
+    for (const auto &entry : m_grass)
+        m_cellStarts[cellId(entry) + 1]++;
+
+    for (size_t i = 1; i < m_cellStarts.size(); ++i)
+        m_cellStarts[i] += m_cellStarts[i - 1];
+
+    std::vector<GrassEntry> sorted(m_grass.size());
+    auto next = m_cellStarts;
+    for (const auto &entry : m_grass)
+        sorted[next[cellId(entry)]++] = entry;
+
+    m_grass = std::move(sorted);
+
+    LOG_INFO("Environment index: {} grass tops in {}x{} cells", m_grass.size(), m_gridSize.x, m_gridSize.y);
 }
 
 void EnvironmentSystem::update()
 {
+    // Only flicking tops have to check if their animation is over
+    for (size_t i = 0; i < m_activeGrass.size();)
+    {
+        const auto idx = m_activeGrass[i];
+        auto *grass = m_reg.try_get<GrassTopComp>(idx);
+        if (!grass || grass->update({.reg=&m_reg, .idx=idx}))
+        {
+            m_activeGrass[i] = m_activeGrass.back();
+            m_activeGrass.pop_back();
+        }
+        else
+            ++i;
+    }
+
+    if (m_grass.empty())
+        return;
+
     auto physicals = m_reg.view<ComponentTransform, ComponentPhysical>();
-    auto grassTops = m_reg.view<ComponentTransform, GrassTopComp>();
+    for (const auto &[idx, trans, phys] : physicals.each())
+    {
+        // Tops only react to horizontal movement
+        const auto avgOffset = phys.appliedOffset.avg();
+        if (phys.appliedOffset.getFilled() == 0 || avgOffset.x == 0)
+            continue;
+
+        const auto lastOffset = phys.appliedOffset[0];
+
+        // Area covered by the pushbox during the last frame, so fast bodies don't skip tops
+        const auto current = phys.pushbox + trans.m_pos;
+        const auto previous = phys.pushbox + (trans.m_pos - lastOffset);
+        const Vector2<int> topLeft{std::min(current.getLeftEdge(), previous.getLeftEdge()), std::min(current.getTopEdge(), previous.getTopEdge())};
+        const Vector2<int> bottomRight{std::max(current.getRightEdge(), previous.getRightEdge()), std::max(current.getBottomEdge(), previous.getBottomEdge())};
+
+        touchGrass({topLeft, bottomRight - topLeft + Vector2{1, 1}}, avgOffset);
+    }
+}
 
-    for (auto [idx, trans, grass] : grassTops.each())
+void EnvironmentSystem::touchGrass(const Collider &swept_, const Vector2<int> &avgOffset_)
+{
+    // Positions of the tops that can reach the swept area
+    const auto first = getCell({swept_.getLeftEdge() - m_grassReach.getRightEdge(), swept_.getTopEdge() - m_grassReach.getBottomEdge()});
+    const auto last = getCell({swept_.getRightEdge() - m_grassReach.getLeftEdge(), swept_.getBottomEdge() - m_grassReach.getTopEdge()});
+
+    const auto &touchingCollider = (avgOffset_.x > 0 ? GrassTopComp::colliderRight : GrassTopComp::colliderLeft);
+
+    for (int y = std::max(first.y, 0); y <= std::min(last.y, m_gridSize.y - 1); ++y)
     {
-        if (grass.update({.reg=&m_reg, .idx=idx}))
+        for (int x = std::max(first.x, 0); x <= std::min(last.x, m_gridSize.x - 1); ++x)
         {
-            for (const auto &[idx2, trans2, phys2] : physicals.each())
+            const auto cell = static_cast<size_t>(y) * m_gridSize.x + x;
+            for (auto i = m_cellStarts[cell]; i < m_cellStarts[cell + 1]; ++i)
             {
-                const auto avgAppliedOffset = phys2.appliedOffset.avg();
-                Collider grassPb;
-                if (avgAppliedOffset.x > 0)
-                    grassPb = GrassTopComp::colliderRight + trans.m_pos;
-                else if (avgAppliedOffset.x <= -0)
-                    grassPb = GrassTopComp::colliderLeft + trans.m_pos;
-                else
+                const auto &entry = m_grass[i];
+                auto *grass = m_reg.try_get<GrassTopComp>(entry.m_entity);
+                if (!grass || grass->m_state != GrassTopComp::State::IDLE)
+                    continue;
+
+                const auto res = swept_.checkOverlap(touchingCollider + entry.m_pos);
+                if ((res & OverlapResult::OVERLAP_BOTH) != OverlapResult::OVERLAP_BOTH)
                     continue;
-                    
-                auto pb = phys2.pushbox + trans2.m_pos;
-                auto res = pb.checkOverlap(grassPb);
-                if ((res & OverlapResult::OVERLAP_BOTH) == OverlapResult::OVERLAP_BOTH)
-                    grass.touchedPlayer(avgAppliedOffset, {.reg=&m_reg, .idx=idx});
+
+                grass->touchedPlayer(avgOffset_, {.reg=&m_reg, .idx=entry.m_entity});
+                if (grass->m_state != GrassTopComp::State::IDLE)
+                    m_activeGrass.push_back(entry.m_entity);
             }
         }
     }
 }
+
+Vector2<int> EnvironmentSystem::getCell(const Vector2<int> &pos_) const noexcept
+{
+    // Floor division, positions left or above the origin get negative cells
+    const auto floorDiv = [](int value_) {
+        return (value_ >= 0 ? value_ / CELL_SIZE : (value_ - CELL_SIZE + 1) / CELL_SIZE);
+    };
+
+    return {floorDiv(pos_.x - m_gridOrigin.x), floorDiv(pos_.y - m_gridOrigin.y)};
+}
@@ -1,14 +1,46 @@
 #pragma once
 #include "Core/Application.h"
+#include "Core/Collider.h"
 #include <entt/entt.hpp>
+#include <vector>
 
+/*
+    Interaction of moving bodies with environment props
+    Grass tops never move, so they are put into a static grid once the level is loaded
+    Each body only looks at the cells its swept pushbox covers, only flicking tops are updated
+*/
 class EnvironmentSystem
 {
 public:
+    static constexpr int CELL_SIZE = 64;
+
     EnvironmentSystem(entt::registry &reg_);
 
+    // Should be called after the level is built, props created later are not interactive
+    void buildIndex();
+
     void update();
 
 private:
+    struct GrassEntry
+    {
+        entt::entity m_entity;
+        Vector2<int> m_pos;
+    };
+
+    void touchGrass(const Collider &swept_, const Vector2<int> &avgOffset_);
+    Vector2<int> getCell(const Vector2<int> &pos_) const noexcept;
+
     entt::registry &m_reg;
+
+    // Row-major, tops of cell i are m_grass[m_cellStarts[i]] to m_grass[m_cellStarts[i + 1]]
+    Vector2<int> m_gridOrigin;
+    Vector2<int> m_gridSize;
+    std::vector<uint32_t> m_cellStarts;
+    std::vector<GrassEntry> m_grass;
+
+    // Area around the top position covered by its colliders
+    Collider m_grassReach;
+
+    std::vector<entt::entity> m_activeGrass;
 };
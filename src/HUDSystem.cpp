@@ -10,13 +10,16 @@
 #include "Core/InputResolver.h"
 #include "Core/Localization/LocalizationGen.h"
 #include "Core/Configuration.h"
+#include <algorithm>
+#include <numeric>
 
-HudSystem::HudSystem(entt::registry &reg_, Camera &cam_, std::string levelname_, const Vector2<float> &lvlSize_, const PlayerSystem &playersys_) :
+HudSystem::HudSystem(entt::registry &reg_, Camera &cam_, std::string levelname_, const Vector2<float> &lvlSize_, const PlayerSystem &playersys_, const RenderSystem &rendersys_) :
     m_renderer(Application::instance().m_renderer),
     m_window{Application::instance().m_window},
     m_textManager(Application::instance().m_textManager),
     m_reg{reg_},
     m_playersys{playersys_},
+    m_rendersys{rendersys_},
     m_cam{cam_},
     m_levelname{std::move(levelname_)},
     m_lvlSize{lvlSize_}
@@ -33,8 +36,15 @@ void HudSystem::draw() const
     const auto npcs = m_reg.view<ComponentTransform, ComponentPhysical/*, StateMachine*/, ComponentAI>();
 #endif
 
+    // All debug text goes on top of the HUD with one draw per atlas page
+    m_textManager.beginBatch();
+
     drawCommonDebug();
 
+#ifdef DUMP_PROFILE_UI
+    drawProfile();
+#endif
+
     const auto playerId = m_playersys.getPlayerId();
     if (playerId != entt::null)
         drawPlayerDebug(playerId);
@@ -48,6 +58,8 @@ void HudSystem::draw() const
         }
 #endif
     }
+
+    m_textManager.endBatch();
 }
 
 void HudSystem::drawCommonDebug() const 
@@ -72,6 +84,10 @@ void HudSystem::drawCommonDebug() const
     commonLog.dumpLine(std::format("Avg frame time (ms): {}", m_avgFrames.avg() / 1'000'000.0f));
     commonLog.dumpLine(std::format("FPS: {}", 1'000'000'000.0f / static_cast<float>(lastFrameTime)));
     commonLog.dumpLine(std::format("Avg FPS: ", 1'000'000'000.0f / m_avgFrames.avg()));
+
+    const auto &renderStats = m_rendersys.getStats();
+    commonLog.dumpLine(std::format("Sprites drawn / culled: {} / {}", renderStats.m_drawn, renderStats.m_culled));
+    commonLog.dumpLine(std::format("Tiles drawn / culled: {} / {}", renderStats.m_tilesDrawn, renderStats.m_tilesCulled));
     commonLog.dumpLine("UTF-8: Кириллица работает");
     commonLog.dumpLine(ll::dbg_localization());
 }
@@ -154,3 +170,79 @@ void HudSystem::drawNPCDebug(const ComponentTransform &trans_, const ComponentPh
     m_textManager.renderText<TextAligners::AlignerLeft>(txt1, Fonts::DBG_NPC, screenOrigin);
     m_textManager.renderText<TextAligners::AlignerLeft>(txt2, Fonts::DBG_NPC, screenOrigin + Vector2{0.0f, 10.0f});
 }
+
+#ifdef DUMP_PROFILE_UI
+void HudSystem::drawProfile() const
+{
+    constexpr int lineHeight = 26;
+    constexpr int barsX = 900;
+    constexpr int barsMaxWidth = 300;
+    constexpr uint64_t frameBudget = 1'000'000'000ull / 60;
+    constexpr size_t topCount = 3;
+
+    const auto toMs = [](uint64_t ns_) {
+        return static_cast<float>(ns_) / 1'000'000.0f;
+    };
+
+    const auto &lastCycleCalls = Application::instance().getFPSUtility().lastCycleCalls;
+    m_profileHistory.collect(lastCycleCalls[0] - lastCycleCalls[1]);
+
+    if (++m_profileFramesSinceRefresh >= s_profileRefreshPeriod)
+    {
+        m_profileFramesSinceRefresh = 0;
+        m_profileHistory.summarize();
+        m_profileLines.clear();
+
+        const auto &places = m_profileHistory.getPlaces();
+        const auto &frame = m_profileHistory.getFramePercentiles();
+        m_profileLines.push_back(std::format("Frame p50/p95/p99 (ms): {:.2f} / {:.2f} / {:.2f}, worst: {:.2f}",
+            toMs(frame.p50), toMs(frame.p95), toMs(frame.p99), toMs(m_profileHistory.getWorstFrameTime())));
+
+        m_profilePlaceLines = places.size();
+        for (const auto &place : places)
+        {
+            m_profileLines.push_back(std::format("{}: {:.3f} / {:.3f} / {:.3f}",
+                place.m_name, toMs(place.m_percentiles.p50), toMs(place.m_percentiles.p95), toMs(place.m_percentiles.p99)));
+        }
+
+        std::vector<size_t> order(places.size());
+        std::iota(order.begin(), order.end(), 0);
+        const auto count = std::min(topCount, order.size());
+
+        std::partial_sort(order.begin(), order.begin() + count, order.end(), [&](size_t lhs_, size_t rhs_) {
+            return places[lhs_].m_inWorstFrame > places[rhs_].m_inWorstFrame;
+        });
+        m_profileLines.push_back("Worst frame:");
+        for (size_t i = 0; i < count; ++i)
+            m_profileLines.push_back(std::format("    {}: {:.3f}", places[order[i]].m_name, toMs(places[order[i]].m_inWorstFrame)));
+
+        std::partial_sort(order.begin(), order.begin() + count, order.end(), [&](size_t lhs_, size_t rhs_) {
+            return places[lhs_].m_avg > places[rhs_].m_avg;
+        });
+        m_profileLines.push_back("Hot:");
+        for (size_t i = 0; i < count; ++i)
+            m_profileLines.push_back(std::format("    {}: {:.3f} avg, {:.1f} calls", places[order[i]].m_name, toMs(places[order[i]].m_avg), places[order[i]].m_callsPerFrame));
+    }
+
+    const Vector2<int> origin{1, 360};
+
+    ImmediateScreenLog<TextAligners::AlignerLeft> profileLog{Fonts::DBG_UI, lineHeight, origin};
+    for (const auto &line : m_profileLines)
+        profileLog.dumpLine(line);
+
+    // Bars show the last frame, same lines as places, with a tick at p99 relative to 60 FPS budget
+    const auto &places = m_profileHistory.getPlaces();
+    // Places registered after the last refresh don't have a line yet, so rows follow the summary of that refresh
+    int lineY = origin.y + lineHeight;
+    for (size_t placeIdx = 0; placeIdx < m_profilePlaceLines; ++placeIdx)
+    {
+        const auto width = static_cast<int>(std::min<uint64_t>(m_profileHistory.getLastTime(placeIdx) * barsMaxWidth / frameBudget, barsMaxWidth));
+        m_renderer.fillRectangle({barsX, lineY + 4}, {std::max(width, 1), lineHeight - 8}, {200, 60, 60, 200});
+
+        const auto p99X = barsX + static_cast<int>(std::min<uint64_t>(places[placeIdx].m_percentiles.p99 * barsMaxWidth / frameBudget, barsMaxWidth));
+        m_renderer.drawLine({p99X, lineY + 2}, {p99X, lineY + lineHeight - 2}, {255, 255, 255, 255});
+
+        lineY += lineHeight;
+    }
+}
+#endif
@@ -4,12 +4,17 @@
 #include "Core/CoreComponents.h"
 #include "Core/Camera.h"
 #include "PlayerSystem.h"
+#include "RenderSystem.h"
+#include "Core/Profile.h"
+#ifdef DUMP_PROFILE_UI
+#include "Core/ProfileHistory.h"
+#endif
 #include <entt/entt.hpp>
 
 struct HudSystem
 {
 public:
-    HudSystem(entt::registry &reg_, Camera &cam_, std::string levelname_, const Vector2<float> &lvlSize_, const PlayerSystem &playersys_);
+    HudSystem(entt::registry &reg_, Camera &cam_, std::string levelname_, const Vector2<float> &lvlSize_, const PlayerSystem &playersys_, const RenderSystem &rendersys_);
 
     void draw() const;
     void drawCommonDebug() const;
@@ -18,6 +23,9 @@ public:
 
     void setPlayerId(entt::entity playerId_) noexcept;
 
+#ifdef DUMP_PROFILE_UI
+    void drawProfile() const;
+#endif
     
 private:
     Renderer &m_renderer;
@@ -25,6 +33,7 @@ private:
     TextManager &m_textManager;
     entt::registry &m_reg;
     const PlayerSystem &m_playersys;
+    const RenderSystem &m_rendersys;
 
     Camera &m_cam;
     const std::string m_levelname;
@@ -33,4 +42,15 @@ private:
 
     std::shared_ptr<Texture> m_arrowIn;
     std::shared_ptr<Texture> m_arrowOut;
+
+#ifdef DUMP_PROFILE_UI
+    // Percentiles and text are only recalculated every s_profileRefreshPeriod frames, bars are updated every frame
+    static constexpr size_t s_profileRefreshPeriod = 15;
+    mutable ProfileHistory m_profileHistory;
+    mutable std::vector<std::string> m_profileLines;
+
+    // Places that had their line at the last refresh, bars are drawn only for them
+    mutable size_t m_profilePlaceLines = 0;
+    mutable size_t m_profileFramesSinceRefresh = s_profileRefreshPeriod;
+#endif
 };
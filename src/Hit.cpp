@@ -1,8 +1,6 @@
 #include "Hit.h"
 #include "Core/Application.h"
 
-uint32_t Hit::m_lastId = 0;
-
 BattleActor::BattleActor(BattleTeams team_) :
     m_team(team_)
 {
@@ -93,7 +91,7 @@ HitboxGroup HitGeneration::hitPlayerAirAttack()
 
 void Hit::updateId()
 {
-    m_id = ++m_lastId;
+    m_id.renew();
 }
 
 HitPosResult detectHit(const std::vector<TemporaryCollider> &hit_, uint32_t hitActiveFrame_, const ComponentTransform &attacker_, const std::vector<TemporaryCollider> &hurtbox_, uint32_t hurtboxActiveFrame_, const ComponentTransform &victim_)
@@ -154,7 +152,7 @@ HealthRendererCommonWRT::HealthRendererCommonWRT(uint8_t realHealth_, const Vect
     auto &animmgmt = Application::instance().m_animationManager;
     for (auto i = 0u; i < realHealth_; ++i)
     {
-        m_heartAnims.emplace_back(animmgmt, animmgmt.getAnimID("UI/heart"), LOOPMETHOD::NOLOOP);
+        m_heartAnims.emplace_back(animmgmt, animmgmt.getAnimID("UI/heart"), LOOPMETHOD::NOLOOP, -1, 1, AnimationTick::MANUAL);
     }
 }
 
@@ -5,7 +5,7 @@
 #include "Core/CoreComponents.h"
 #include "Core/FrameTimer.h"
 #include "SM/StateMachine.h"
-#include <set>
+#include "HitRegistry.h"
 
 enum class HurtTrait : uint8_t {
     VULNERABLE,
@@ -18,6 +18,29 @@ enum class BattleTeams : uint8_t {
     NONE
 };
 
+// Set of teams stored as bits
+class TeamMask
+{
+public:
+    constexpr void insert(BattleTeams team_) noexcept
+    {
+        m_mask |= bit(team_);
+    }
+
+    constexpr bool contains(BattleTeams team_) const noexcept
+    {
+        return m_mask & bit(team_);
+    }
+
+private:
+    static constexpr uint8_t bit(BattleTeams team_) noexcept
+    {
+        return static_cast<uint8_t>(1 << static_cast<uint8_t>(team_));
+    }
+
+    uint8_t m_mask = 0;
+};
+
 struct TemporaryCollider
 {
     Collider m_collider;
@@ -52,18 +75,18 @@ struct CamShakeDescr
 
 struct Hit
 {
-    static uint32_t m_lastId;
-    uint32_t m_id = 0;
+    HitId m_id;
 
     int m_damage = false;
     uint32_t m_hitstun = 0;
     float m_stagger = 0.0f;
     uint32_t m_hitstop = 0;
-    std::set<BattleTeams> m_friendTeams;
+    TeamMask m_friendTeams;
     std::unique_ptr<Flash> m_victimFlash;
 
     CamShakeDescr m_onHitShake;
     
+    // Should be called when the hit starts again, so it can land on the same actors
     void updateId();
 };
 
@@ -96,7 +119,7 @@ struct BattleActor
     uint32_t m_currentFrame = 0;
     BattleTeams m_team = BattleTeams::NONE;
     std::vector<const HitboxGroup *> m_activeHits;
-    std::set<uint32_t> m_appliedHits;
+    AppliedHits m_appliedHits;
     const HitStateMapping *m_hitStateTransitions = nullptr;
 };
 
@@ -0,0 +1,171 @@
+#include "HitDetection.h"
+#include "Hit.h"
+#include "Core/Profile.h"
+#include "Core/Utils.hpp"
+#include <algorithm>
+
+namespace
+{
+    int toCell(int coord_)
+    {
+        // Rounds towards negative infinity, so cells don't stretch around zero
+        return (coord_ >= 0 ? coord_ / HitDetector::CELL_SIZE : (coord_ + 1) / HitDetector::CELL_SIZE - 1);
+    }
+
+    uint64_t cellKey(int x_, int y_)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x_)) << 32) | static_cast<uint32_t>(y_);
+    }
+
+    Collider merge(const Collider &lhs_, const Collider &rhs_)
+    {
+        const Vector2<int> tl{std::min(lhs_.getLeftEdge(), rhs_.getLeftEdge()), std::min(lhs_.getTopEdge(), rhs_.getTopEdge())};
+        const Vector2<int> br{std::max(lhs_.getRightEdge(), rhs_.getRightEdge()), std::max(lhs_.getBottomEdge(), rhs_.getBottomEdge())};
+        return {.m_topLeft=tl, .m_size=br - tl + Vector2{1, 1}};
+    }
+
+    bool overlaps(const Collider &lhs_, const Collider &rhs_)
+    {
+        const auto overlap = lhs_.getOverlapArea(rhs_);
+        return overlap.m_size.x > 0 && overlap.m_size.y > 0;
+    }
+}
+
+template<typename FuncT>
+void HitDetector::forEachCell(const Collider &bounds_, FuncT &&func_)
+{
+    const auto right = toCell(bounds_.getRightEdge());
+    const auto bottom = toCell(bounds_.getBottomEdge());
+    for (auto x = toCell(bounds_.getLeftEdge()); x <= right; ++x)
+    {
+        for (auto y = toCell(bounds_.getTopEdge()); y <= bottom; ++y)
+            func_(cellKey(x, y));
+    }
+}
+
+void HitDetector::collect(entt::registry &reg_)
+{
+    PROFILE_FUNCTION;
+
+    m_hitColliders.clear();
+    m_hurtColliders.clear();
+    m_attacks.clear();
+    m_hurts.clear();
+
+    auto viewBtl = reg_.view<BattleActor, StateMachine, ComponentTransform>();
+    for (auto [idx, btl, sm, trans] : viewBtl.each())
+    {
+        for (const auto *atk : btl.m_activeHits)
+            addAttack(idx, *atk, btl.m_currentFrame, trans);
+
+        if (btl.m_hurtboxes)
+        {
+            for (const auto &hurtGroup : *btl.m_hurtboxes)
+                addHurtbox(idx, btl, hurtGroup, trans);
+        }
+    }
+
+    buildCells();
+}
+
+const std::vector<HitDetector::LandedHit> &HitDetector::detect()
+{
+    PROFILE_FUNCTION;
+
+    m_landed.clear();
+
+    for (const auto &atk : m_attacks)
+    {
+        // Group can be registered in several cells
+        m_candidates.clear();
+        forEachCell(atk.m_bounds, [&](uint64_t cell_) {
+            auto it = std::lower_bound(m_cells.begin(), m_cells.end(), cell_, [](const CellEntry &entry_, uint64_t key_) { return entry_.m_cell < key_; });
+            for (; it != m_cells.end() && it->m_cell == cell_; ++it)
+                m_candidates.push_back(it->m_hurt);
+        });
+
+        // Groups of a single actor are stored in order, so the first group that was hit is the same as in hurtbox description
+        std::sort(m_candidates.begin(), m_candidates.end());
+        m_candidates.erase(std::unique(m_candidates.begin(), m_candidates.end()), m_candidates.end());
+
+        const auto &hitData = atk.m_hit->m_hitData;
+        const auto hitTag = hitData.m_id.tag();
+        for (const auto hurtIdx : m_candidates)
+        {
+            const auto &hurt = m_hurts[hurtIdx];
+            if (hurt.m_owner == atk.m_owner || hitData.m_friendTeams.contains(hurt.m_actor->m_team))
+                continue;
+
+            if (hurt.m_actor->m_appliedHits.contains(hitTag) || !overlaps(atk.m_bounds, hurt.m_bounds))
+                continue;
+
+            utils::Average<Vector2<float>> avgpos;
+            for (auto hitCld = atk.m_begin; hitCld < atk.m_end; ++hitCld)
+            {
+                for (auto hurtCld = hurt.m_begin; hurtCld < hurt.m_end; ++hurtCld)
+                {
+                    auto overlap = m_hitColliders[hitCld].getOverlapArea(m_hurtColliders[hurtCld]);
+                    if (overlap.m_size.x > 0 && overlap.m_size.y > 0)
+                        avgpos += overlap.m_topLeft + overlap.m_size / 2.0f;
+                }
+            }
+
+            if (avgpos.isSet())
+            {
+                hurt.m_actor->m_appliedHits.insert(hitTag);
+                m_landed.push_back({atk.m_owner, hurt.m_owner, atk.m_hit, avgpos});
+            }
+        }
+    }
+
+    return m_landed;
+}
+
+void HitDetector::addAttack(entt::entity owner_, const HitboxGroup &hit_, uint32_t frame_, const ComponentTransform &trans_)
+{
+    const auto begin = static_cast<uint32_t>(m_hitColliders.size());
+    for (const auto &hitbox : hit_.m_colliders)
+    {
+        if (hitbox.m_timeline[frame_])
+            m_hitColliders.push_back(getColliderAt(hitbox.m_collider, trans_));
+    }
+
+    const auto end = static_cast<uint32_t>(m_hitColliders.size());
+    if (begin == end)
+        return;
+
+    auto bounds = m_hitColliders[begin];
+    for (auto i = begin + 1; i < end; ++i)
+        bounds = merge(bounds, m_hitColliders[i]);
+
+    m_attacks.push_back({owner_, &hit_, begin, end, bounds});
+}
+
+void HitDetector::addHurtbox(entt::entity owner_, BattleActor &actor_, const HurtboxGroup &group_, const ComponentTransform &trans_)
+{
+    const auto begin = static_cast<uint32_t>(m_hurtColliders.size());
+    for (const auto &hurtbox : group_.m_colliders)
+    {
+        if (hurtbox.m_timeline[actor_.m_currentFrame])
+            m_hurtColliders.push_back(getColliderAt(hurtbox.m_collider, trans_));
+    }
+
+    const auto end = static_cast<uint32_t>(m_hurtColliders.size());
+    if (begin == end)
+        return;
+
+    auto bounds = m_hurtColliders[begin];
+    for (auto i = begin + 1; i < end; ++i)
+        bounds = merge(bounds, m_hurtColliders[i]);
+
+    m_hurts.push_back({owner_, &actor_, begin, end, bounds});
+}
+
+void HitDetector::buildCells()
+{
+    m_cells.clear();
+    for (uint32_t i = 0; i < m_hurts.size(); ++i)
+        forEachCell(m_hurts[i].m_bounds, [&](uint64_t cell_) { m_cells.push_back({cell_, i}); });
+
+    std::sort(m_cells.begin(), m_cells.end(), [](const CellEntry &lhs_, const CellEntry &rhs_) { return lhs_.m_cell < rhs_.m_cell; });
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "Core/RectCollider.h"
+#include "Core/Vector2.hpp"
+#include <entt/entt.hpp>
+#include <vector>
+
+struct BattleActor;
+struct HitboxGroup;
+struct HurtboxGroup;
+struct ComponentTransform;
+
+/*
+    Finds attacks that landed during the current frame
+    Active hitboxes and hurtboxes are resolved into world colliders once per frame,
+    hurtbox groups are put into a spatial hash, so every attack is tested only against groups in the cells it touches
+    Spatial hash is a sorted array of (cell, group) pairs, it doesn't allocate once buffers grow to the usual battle size
+*/
+class HitDetector
+{
+public:
+    static constexpr int CELL_SIZE = 64;
+
+    struct LandedHit
+    {
+        entt::entity m_attacker;
+        entt::entity m_victim;
+        const HitboxGroup *m_hit;
+        Vector2<float> m_hitPos;
+    };
+
+    // Resolves colliders of all battle actors for their current frames
+    void collect(entt::registry &reg_);
+
+    /*
+        Every attack lands on a victim at most once, hits are filtered by friend teams and already applied hits
+        Landed hits are marked as applied in the victim's BattleActor
+        Result is valid until the next collect()
+    */
+    const std::vector<LandedHit> &detect();
+
+private:
+    // Ranges point into m_hitColliders or m_hurtColliders, bounds cover all colliders in range
+    struct AttackRecord
+    {
+        entt::entity m_owner;
+        const HitboxGroup *m_hit;
+        uint32_t m_begin;
+        uint32_t m_end;
+        Collider m_bounds;
+    };
+
+    struct HurtRecord
+    {
+        entt::entity m_owner;
+        BattleActor *m_actor;
+        uint32_t m_begin;
+        uint32_t m_end;
+        Collider m_bounds;
+    };
+
+    struct CellEntry
+    {
+        uint64_t m_cell;
+        uint32_t m_hurt;
+    };
+
+    void addAttack(entt::entity owner_, const HitboxGroup &hit_, uint32_t frame_, const ComponentTransform &trans_);
+    void addHurtbox(entt::entity owner_, BattleActor &actor_, const HurtboxGroup &group_, const ComponentTransform &trans_);
+    void buildCells();
+
+    template<typename FuncT>
+    static void forEachCell(const Collider &bounds_, FuncT &&func_);
+
+    std::vector<Collider> m_hitColliders;
+    std::vector<Collider> m_hurtColliders;
+    std::vector<AttackRecord> m_attacks;
+    std::vector<HurtRecord> m_hurts;
+
+    // Sorted by cell
+    std::vector<CellEntry> m_cells;
+
+    std::vector<uint32_t> m_candidates;
+    std::vector<LandedHit> m_landed;
+};
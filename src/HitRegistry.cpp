@@ -0,0 +1,116 @@
+#include "HitRegistry.h"
+#include <utility>
+
+HitRegistry &HitRegistry::instance()
+{
+    static HitRegistry registry;
+    return registry;
+}
+
+uint32_t HitRegistry::acquire()
+{
+    if (!m_freeSlots.empty())
+    {
+        const auto slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return slot;
+    }
+
+    m_generations.push_back(0);
+    return static_cast<uint32_t>(m_generations.size() - 1);
+}
+
+void HitRegistry::release(uint32_t slot_)
+{
+    // Next owner of the slot shouldn't inherit applications of the previous one
+    m_generations[slot_]++;
+    m_freeSlots.push_back(slot_);
+}
+
+void HitRegistry::retire(const HitTag &tag_) noexcept
+{
+    if (isAlive(tag_))
+        m_generations[tag_.m_slot]++;
+}
+
+HitTag HitRegistry::current(uint32_t slot_) const noexcept
+{
+    return {slot_, m_generations[slot_]};
+}
+
+bool HitRegistry::isAlive(const HitTag &tag_) const noexcept
+{
+    return tag_.m_slot < m_generations.size() && m_generations[tag_.m_slot] == tag_.m_generation;
+}
+
+HitId::HitId() :
+    m_slot{HitRegistry::instance().acquire()}
+{
+}
+
+HitId::HitId(HitId &&rhs_) noexcept :
+    m_slot{std::exchange(rhs_.m_slot, HitTag::INVALID_SLOT)}
+{
+}
+
+HitId &HitId::operator=(HitId &&rhs_) noexcept
+{
+    if (this != &rhs_)
+    {
+        if (m_slot != HitTag::INVALID_SLOT)
+            HitRegistry::instance().release(m_slot);
+
+        m_slot = std::exchange(rhs_.m_slot, HitTag::INVALID_SLOT);
+    }
+
+    return *this;
+}
+
+HitId::~HitId()
+{
+    if (m_slot != HitTag::INVALID_SLOT)
+        HitRegistry::instance().release(m_slot);
+}
+
+void HitId::renew() noexcept
+{
+    HitRegistry::instance().retire(tag());
+}
+
+HitTag HitId::tag() const noexcept
+{
+    if (m_slot == HitTag::INVALID_SLOT)
+        return {};
+
+    return HitRegistry::instance().current(m_slot);
+}
+
+bool AppliedHits::contains(const HitTag &tag_) const noexcept
+{
+    if (tag_.m_slot == HitTag::INVALID_SLOT)
+        return false;
+
+    for (const auto &hit : m_hits)
+    {
+        if (hit == tag_)
+            return true;
+    }
+
+    return false;
+}
+
+void AppliedHits::insert(const HitTag &tag_) noexcept
+{
+    const auto &registry = HitRegistry::instance();
+    for (auto &hit : m_hits)
+    {
+        if (!registry.isAlive(hit))
+        {
+            hit = tag_;
+            return;
+        }
+    }
+
+    m_hits[m_nextOverwrite] = tag_;
+    m_nextOverwrite = static_cast<uint8_t>((m_nextOverwrite + 1) % CAPACITY);
+}
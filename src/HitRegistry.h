@@ -0,0 +1,78 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Identifies a single instance of a hit, becomes stale once that instance is retired
+struct HitTag
+{
+    static constexpr uint32_t INVALID_SLOT = std::numeric_limits<uint32_t>::max();
+
+    uint32_t m_slot = INVALID_SLOT;
+    uint32_t m_generation = 0;
+
+    bool operator==(const HitTag &rhs_) const noexcept = default;
+};
+
+/*
+    Slots of all existing hits with their current generations
+    Retiring a hit bumps generation of its slot, so every tag of the previous instance stops matching at once
+*/
+class HitRegistry
+{
+public:
+    static HitRegistry &instance();
+
+    uint32_t acquire();
+    void release(uint32_t slot_);
+
+    // Does nothing if this instance is already retired
+    void retire(const HitTag &tag_) noexcept;
+
+    HitTag current(uint32_t slot_) const noexcept;
+    bool isAlive(const HitTag &tag_) const noexcept;
+
+private:
+    std::vector<uint32_t> m_generations;
+    std::vector<uint32_t> m_freeSlots;
+};
+
+// Owns a slot in HitRegistry for the lifetime of a hit
+class HitId
+{
+public:
+    HitId();
+    HitId(const HitId&) = delete;
+    HitId &operator=(const HitId&) = delete;
+    HitId(HitId &&rhs_) noexcept;
+    HitId &operator=(HitId &&rhs_) noexcept;
+    ~HitId();
+
+    // Starts a new instance of the hit, all previous applications are forgotten
+    void renew() noexcept;
+
+    HitTag tag() const noexcept;
+
+private:
+    uint32_t m_slot = HitTag::INVALID_SLOT;
+};
+
+/*
+    Hits that already landed on an actor
+    Tags of retired hits are stale and get overwritten by new ones, so nothing has to clean it up
+    If more than CAPACITY live hits landed, live tags are overwritten in round robin order
+*/
+class AppliedHits
+{
+public:
+    static constexpr size_t CAPACITY = 8;
+
+    bool contains(const HitTag &tag_) const noexcept;
+    void insert(const HitTag &tag_) noexcept;
+
+private:
+    std::array<HitTag, CAPACITY> m_hits;
+    uint8_t m_nextOverwrite = 0;
+};
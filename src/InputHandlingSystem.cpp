@@ -1,4 +1,5 @@
 #include "InputHandlingSystem.h"
+#include "Core/Application.h"
 #include "Core/InputResolver.h"
 #include "Core/Profile.h"
 #include <stdexcept>
@@ -20,23 +21,23 @@ void InputHandlingSystem::receiveEvents(GAMEPLAY_EVENTS event_, float scale_)
     switch (event_)
     {
         case (GAMEPLAY_EVENTS::UP):
-            m_currentInput.m_inputs[INPUT_BUTTON::UP] = (scale_ > 0.0f ? (m_currentInput.m_inputs[INPUT_BUTTON::UP] != INPUT_BUTTON_STATE::HOLD ? INPUT_BUTTON_STATE::PRESSED : INPUT_BUTTON_STATE::HOLD) : INPUT_BUTTON_STATE::RELEASED);
+            m_currentInput.setButton(INPUT_BUTTON::UP, (scale_ > 0.0f ? (m_currentInput.getButton(INPUT_BUTTON::UP) != INPUT_BUTTON_STATE::HOLD ? INPUT_BUTTON_STATE::PRESSED : INPUT_BUTTON_STATE::HOLD) : INPUT_BUTTON_STATE::RELEASED));
             break;
 
         case (GAMEPLAY_EVENTS::DOWN):
-            m_currentInput.m_inputs[INPUT_BUTTON::DOWN] = (scale_ > 0.0f ? (m_currentInput.m_inputs[INPUT_BUTTON::DOWN] != INPUT_BUTTON_STATE::HOLD ? INPUT_BUTTON_STATE::PRESSED : INPUT_BUTTON_STATE::HOLD) : INPUT_BUTTON_STATE::RELEASED);
+            m_currentInput.setButton(INPUT_BUTTON::DOWN, (scale_ > 0.0f ? (m_currentInput.getButton(INPUT_BUTTON::DOWN) != INPUT_BUTTON_STATE::HOLD ? INPUT_BUTTON_STATE::PRESSED : INPUT_BUTTON_STATE::HOLD) : INPUT_BUTTON_STATE::RELEASED));
             break;
 
         case (GAMEPLAY_EVENTS::LEFT):
-            m_currentInput.m_inputs[INPUT_BUTTON::LEFT] = (scale_ > 0.0f ? (m_currentInput.m_inputs[INPUT_BUTTON::LEFT] != INPUT_BUTTON_STATE::HOLD ? INPUT_BUTTON_STATE::PRESSED : INPUT_BUTTON_STATE::HOLD) : INPUT_BUTTON_STATE::RELEASED);
+            m_currentInput.setButton(INPUT_BUTTON::LEFT, (scale_ > 0.0f ? (m_currentInput.getButton(INPUT_BUTTON::LEFT) != INPUT_BUTTON_STATE::HOLD ? INPUT_BUTTON_STATE::PRESSED : INPUT_BUTTON_STATE::HOLD) : INPUT_BUTTON_STATE::RELEASED));
             break;
 
         case (GAMEPLAY_EVENTS::RIGHT):
-            m_currentInput.m_inputs[INPUT_BUTTON::RIGHT] = (scale_ > 0.0f ? (m_currentInput.m_inputs[INPUT_BUTTON::RIGHT] != INPUT_BUTTON_STATE::HOLD ? INPUT_BUTTON_STATE::PRESSED : INPUT_BUTTON_STATE::HOLD) : INPUT_BUTTON_STATE::RELEASED);
+            m_currentInput.setButton(INPUT_BUTTON::RIGHT, (scale_ > 0.0f ? (m_currentInput.getButton(INPUT_BUTTON::RIGHT) != INPUT_BUTTON_STATE::HOLD ? INPUT_BUTTON_STATE::PRESSED : INPUT_BUTTON_STATE::HOLD) : INPUT_BUTTON_STATE::RELEASED));
             break;
         
         case (GAMEPLAY_EVENTS::ATTACK):
-            m_currentInput.m_inputs[INPUT_BUTTON::ATTACK] = (scale_ > 0.0f ? INPUT_BUTTON_STATE::PRESSED : INPUT_BUTTON_STATE::RELEASED);
+            m_currentInput.setButton(INPUT_BUTTON::ATTACK, (scale_ > 0.0f ? INPUT_BUTTON_STATE::PRESSED : INPUT_BUTTON_STATE::RELEASED));
             break;
 
         default:
@@ -46,13 +47,13 @@ void InputHandlingSystem::receiveEvents(GAMEPLAY_EVENTS event_, float scale_)
 
 void InputHandlingSystem::update()
 {
-    m_currentInput.setDirFromButtons();
+    const auto frameInput = Application::instance().m_inputSession.processFrame(m_currentInput);
 
     auto view = m_reg.view<InputResolver>();
 
     for (auto [idx, inputs] : view.each())
     {
-        inputs.addFrame(m_currentInput);
+        inputs.addFrame(frameInput);
     }
 
     m_currentInput = m_currentInput.getNextFrameState();
@@ -5,6 +5,7 @@
 #include "Core/JsonUtils.hpp"
 #include "Core/NavGraph.h"
 #include "Core/CoreComponents.h"
+#include "Core/PropSet.h"
 #include "Core/CameraFocusArea.h"
 #include "Core/FilesystemUtils.h"
 #include "Core/Logger.hpp"
@@ -18,30 +19,46 @@ template <>
 void LevelBuilder::makeObject<GrassTopComp>(const Vector2<int> &pos_, bool visible_, int layer_)
 {
     auto &animManager = Application::instance().m_animationManager;
+    const auto idleId = animManager.getAnimID("Environment/grass_single_top");
 
-    auto objEnt = m_reg.create();
-    auto &trans = m_reg.emplace<ComponentTransform>(objEnt, pos_, Orientation::RIGHT);
+    // All grass on the same layer is drawn by a single prop set, clips are added in GrassTopComp::State order
+    auto setEnt = getPropSet(idleId, layer_, visible_);
+    auto &props = m_reg.get<PropSet>(setEnt);
+    if (props.getClipCount() == 0)
+    {
+        props.addClip(animManager, idleId, LOOPMETHOD::JUMP_LOOP);
+        props.addClip(animManager, animManager.getAnimID("Environment/grass_single_top_flickL"), LOOPMETHOD::NOLOOP);
+        props.addClip(animManager, animManager.getAnimID("Environment/grass_single_top_flickR"), LOOPMETHOD::NOLOOP);
+    }
 
-    auto &animrnd = m_reg.emplace<ComponentAnimationRenderable>(objEnt);
-    m_reg.emplace<RenderLayer>(objEnt, layer_, visible_);
+    const auto idleClip = static_cast<uint8_t>(GrassTopComp::State::IDLE);
+    const auto animSize = props.getSize(idleClip);
+    const auto animOrigin = props.getOrigin(idleClip);
 
-    animrnd.loadAnimation(animManager, animManager.getAnimID("Environment/grass_single_top"));
-    animrnd.loadAnimation(animManager, animManager.getAnimID("Environment/grass_single_top_flickL"), LOOPMETHOD::NOLOOP);
-    animrnd.loadAnimation(animManager, animManager.getAnimID("Environment/grass_single_top_flickR"), LOOPMETHOD::NOLOOP);
+    auto objEnt = m_reg.create();
+    auto &trans = m_reg.emplace<ComponentTransform>(objEnt, pos_, Orientation::RIGHT);
+    trans.m_pos.x += (animOrigin.x - 1);
+    trans.m_pos.y -= (animSize.y + 1 - animOrigin.y);
 
-    auto animSize = animrnd.m_animations.at(animManager.getAnimID("Environment/grass_single_top")).getSize();
-    auto animOrigin = animrnd.m_animations.at(animManager.getAnimID("Environment/grass_single_top")).getOrigin();
+    auto &grass = m_reg.emplace<GrassTopComp>(objEnt);
+    grass.m_propSet = setEnt;
+    grass.m_instance = props.addInstance(trans.m_pos, idleClip);
+}
 
-    animrnd.m_currentAnimation = &animrnd.m_animations.at(animManager.getAnimID("Environment/grass_single_top"));
-    animrnd.m_currentAnimation->reset();
+entt::entity LevelBuilder::getPropSet(ResID kind_, int layer_, bool visible_)
+{
+    for (const auto &[idx, props, renlayer] : m_reg.view<PropSet, RenderLayer>().each())
+    {
+        if (props.getKind() == kind_ && renlayer.getDepth() == layer_ && renlayer.isVisible() == visible_)
+            return idx;
+    }
 
-    trans.m_pos.x += (animOrigin.x - 1);
-    trans.m_pos.y -= (animSize.y + 1 - animOrigin.y);
+    auto setEnt = m_reg.create();
+    m_reg.emplace<ComponentTransform>(setEnt, Vector2{0, 0}, Orientation::RIGHT);
+    m_reg.emplace<RenderLayer>(setEnt, layer_, visible_);
+    m_reg.emplace<PropSet>(setEnt, kind_);
 
-    m_reg.emplace<GrassTopComp>(objEnt);
-    GrassTopComp::m_idleAnimId = animManager.getAnimID("Environment/grass_single_top");
-    GrassTopComp::m_flickRightAnimId = animManager.getAnimID("Environment/grass_single_top_flickR");
-    GrassTopComp::m_flickLeftAnimId = animManager.getAnimID("Environment/grass_single_top_flickL");
+    return setEnt;
 }
 
 LevelBuilder::LevelBuilder(entt::registry &reg_) :
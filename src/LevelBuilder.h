@@ -57,6 +57,9 @@ private:
     template<typename T>
     void makeObject(const Vector2<int> &pos_, bool visible_, int layer_) = delete;
 
+    // Finds or creates the entity that draws all props of kind_ on a layer
+    entt::entity getPropSet(ResID kind_, int layer_, bool visible_);
+
     using FactoryMethod = void (LevelBuilder::*)(const Vector2<int>&, bool, int);
 
     std::map<std::string, FactoryMethod> m_factories;
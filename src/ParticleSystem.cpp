@@ -1,6 +1,9 @@
 #include "ParticleSystem.h"
 #include "Core/CoreComponents.h"
 #include "Core/Application.h"
+#include "Core/Profile.h"
+#include <algorithm>
+#include <limits>
 
 ParticleRecipe::ParticleRecipe(ResID anim_, uint32_t lifetime_, int layer_) :
     anim{anim_},
@@ -30,19 +33,206 @@ ParticleEmissionRuleset &ParticleEmissionRuleset::destroyOnStateChange() noexcep
     return *this;
 }
 
+ParticlePool::ParticlePool(std::shared_ptr<TextureArr> textures_, ResID anim_, int layer_, TiePosRule tiePosRule_) :
+    m_textures{std::move(textures_)},
+    m_anim{anim_},
+    m_layer{layer_},
+    m_tiePosRule{tiePosRule_}
+{
+}
+
+ParticleHandle ParticlePool::spawn(uint32_t poolId_, const Vector2<int> &pos_, Orientation orientation_, uint32_t lifetime_, entt::entity tie_)
+{
+    uint32_t slot = 0;
+    if (!m_freeSlots.empty())
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<uint32_t>(m_slotToDense.size());
+        m_slotToDense.push_back(0);
+        m_slotGenerations.push_back(0);
+    }
+
+    m_slotToDense[slot] = static_cast<uint32_t>(m_positions.size());
+    m_positions.push_back(pos_);
+    m_orientations.push_back(orientation_);
+    m_angles.push_back(0.0f);
+    m_frames.push_back(0);
+    m_lifetimes.push_back(lifetime_ == 0 ? std::numeric_limits<uint32_t>::max() : lifetime_);
+    m_ties.push_back(tie_);
+    m_denseToSlot.push_back(slot);
+
+    return {poolId_, slot, m_slotGenerations[slot]};
+}
+
+void ParticlePool::destroy(const ParticleHandle &handle_)
+{
+    if (handle_.m_slot >= m_slotGenerations.size() || m_slotGenerations[handle_.m_slot] != handle_.m_generation)
+        return;
+
+    removeAt(m_slotToDense[handle_.m_slot]);
+}
+
+void ParticlePool::update(const entt::registry &reg_)
+{
+    const auto count = m_frames.size();
+
+    // Plain loops over contiguous arrays without branches, so they can be vectorized
+    for (size_t i = 0; i < count; ++i)
+        m_frames[i]++;
+
+    size_t expired = 0;
+    for (size_t i = 0; i < count; ++i)
+        expired += (m_frames[i] >= m_lifetimes[i]);
+
+    if (m_tiePosRule == TiePosRule::TIE_TO_EMITTER)
+    {
+        for (size_t i = count; i-- > 0;)
+        {
+            if (m_frames[i] >= m_lifetimes[i] || !reg_.valid(m_ties[i]))
+                removeAt(i);
+        }
+    }
+    else if (expired > 0)
+    {
+        // Going backwards, so the particle swapped into i is already checked
+        for (size_t i = count; i-- > 0;)
+        {
+            if (m_frames[i] >= m_lifetimes[i])
+                removeAt(i);
+        }
+    }
+}
+
+void ParticlePool::removeAt(size_t idx_)
+{
+    const auto slot = m_denseToSlot[idx_];
+    const auto last = m_positions.size() - 1;
+
+    if (idx_ != last)
+    {
+        m_positions[idx_] = m_positions[last];
+        m_orientations[idx_] = m_orientations[last];
+        m_angles[idx_] = m_angles[last];
+        m_frames[idx_] = m_frames[last];
+        m_lifetimes[idx_] = m_lifetimes[last];
+        m_ties[idx_] = m_ties[last];
+        m_denseToSlot[idx_] = m_denseToSlot[last];
+        m_slotToDense[m_denseToSlot[idx_]] = static_cast<uint32_t>(idx_);
+    }
+
+    m_positions.pop_back();
+    m_orientations.pop_back();
+    m_angles.pop_back();
+    m_frames.pop_back();
+    m_lifetimes.pop_back();
+    m_ties.pop_back();
+    m_denseToSlot.pop_back();
+
+    m_slotGenerations[slot]++;
+    m_freeSlots.push_back(slot);
+}
+
+size_t ParticlePool::size() const noexcept
+{
+    return m_positions.size();
+}
+
+ResID ParticlePool::getAnim() const noexcept
+{
+    return m_anim;
+}
+
+int ParticlePool::getLayer() const noexcept
+{
+    return m_layer;
+}
+
+TiePosRule ParticlePool::getTiePosRule() const noexcept
+{
+    return m_tiePosRule;
+}
+
+const TextureArr &ParticlePool::getTextures() const noexcept
+{
+    return *m_textures;
+}
+
+uint32_t ParticlePool::getFrame(size_t idx_) const noexcept
+{
+    // Frame counter is already updated once on the frame particle was spawned
+    const auto frame = m_frames[idx_];
+    return (frame > 0 ? frame - 1 : 0) % m_textures->duration();
+}
+
+const std::vector<Vector2<int>> &ParticlePool::getPositions() const noexcept
+{
+    return m_positions;
+}
+
+const std::vector<Orientation> &ParticlePool::getOrientations() const noexcept
+{
+    return m_orientations;
+}
+
+const std::vector<float> &ParticlePool::getAngles() const noexcept
+{
+    return m_angles;
+}
+
+const std::vector<entt::entity> &ParticlePool::getTies() const noexcept
+{
+    return m_ties;
+}
+
 ParticleSystem::ParticleSystem(entt::registry &reg_) :
     m_registry(reg_),
     m_animmgmt(Application::instance().m_animationManager)
 {
 }
 
+void ParticleSystem::destroyParticle(const ParticleHandle &handle_)
+{
+    if (handle_.m_pool < m_pools.size())
+        m_pools[handle_.m_pool]->destroy(handle_);
+}
+
 void ParticleSystem::update()
 {
-    auto viewParticles = m_registry.view<ComponentParticlePrimitive>();
+    PROFILE_FUNCTION;
 
-    for (const auto &[idx, pprim] : viewParticles.each())
+    for (auto &pool : m_pools)
+        pool->update(m_registry);
+}
+
+const std::vector<const ParticlePool*> &ParticleSystem::getPoolsByDepth() const noexcept
+{
+    return m_poolsByDepth;
+}
+
+ParticlePool &ParticleSystem::getPool(const ParticleRecipe &particle_, uint32_t &poolId_)
+{
+    for (uint32_t i = 0; i < m_pools.size(); ++i)
     {
-        if (pprim.lifetime.update())
-            m_registry.destroy(idx);
+        const auto &pool = *m_pools[i];
+        if (pool.getAnim() == particle_.anim && pool.getLayer() == particle_.layer && pool.getTiePosRule() == particle_.tiePosRule)
+        {
+            poolId_ = i;
+            return *m_pools[i];
+        }
     }
+
+    poolId_ = static_cast<uint32_t>(m_pools.size());
+    auto &pool = *m_pools.emplace_back(std::make_unique<ParticlePool>(m_animmgmt.getTextureArr(particle_.anim), particle_.anim, particle_.layer, particle_.tiePosRule));
+
+    // Same order as RenderLayer sorting: higher depth is drawn first
+    const auto pos = std::upper_bound(m_poolsByDepth.begin(), m_poolsByDepth.end(), &pool, [](const ParticlePool *lhs_, const ParticlePool *rhs_) {
+        return lhs_->getLayer() > rhs_->getLayer();
+    });
+    m_poolsByDepth.insert(pos, &pool);
+
+    return pool;
 }
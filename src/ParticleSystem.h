@@ -2,8 +2,11 @@
 #include "Core/AnimationManager.h"
 #include "Core/Vector2.hpp"
 #include "Core/ECS/ComponentsView.h"
+#include "Core/CoreComponents.h"
 #include <entt/entt.hpp>
 #include <SDL3/SDL.h>
+#include <memory>
+#include <vector>
 
 enum class TiePosRule : uint8_t
 {
@@ -37,18 +40,86 @@ struct ParticleEmissionRuleset
     bool mustDestroyOnStateChange = false;
 };
 
+/*
+    All particles of a single recipe, stored as structure of arrays
+    Particles are densely packed, expired ones are swapped with the last one
+    Handles point to slots that map into the dense arrays, slot generation is bumped when particle expires
+*/
+class ParticlePool
+{
+public:
+    ParticlePool(std::shared_ptr<TextureArr> textures_, ResID anim_, int layer_, TiePosRule tiePosRule_);
+
+    // Lifetime 0 means particle lives until it is destroyed explicitly
+    ParticleHandle spawn(uint32_t poolId_, const Vector2<int> &pos_, Orientation orientation_, uint32_t lifetime_, entt::entity tie_);
+    void destroy(const ParticleHandle &handle_);
+
+    // Particles tied to destroyed entities expire with them
+    void update(const entt::registry &reg_);
+
+    size_t size() const noexcept;
+    ResID getAnim() const noexcept;
+    int getLayer() const noexcept;
+    TiePosRule getTiePosRule() const noexcept;
+    const TextureArr &getTextures() const noexcept;
+
+    // Animation frame of the particle, loops like JUMP_LOOP animation
+    uint32_t getFrame(size_t idx_) const noexcept;
+
+    // Position is an offset from the tied entity if particle is tied to emitter
+    const std::vector<Vector2<int>> &getPositions() const noexcept;
+    const std::vector<Orientation> &getOrientations() const noexcept;
+    const std::vector<float> &getAngles() const noexcept;
+    const std::vector<entt::entity> &getTies() const noexcept;
+
+private:
+    void removeAt(size_t idx_);
+
+    const std::shared_ptr<TextureArr> m_textures;
+    const ResID m_anim;
+    const int m_layer;
+    const TiePosRule m_tiePosRule;
+
+    // Dense arrays, all have the same size
+    std::vector<Vector2<int>> m_positions;
+    std::vector<Orientation> m_orientations;
+    std::vector<float> m_angles;
+    std::vector<uint32_t> m_frames;
+    std::vector<uint32_t> m_lifetimes;
+    std::vector<entt::entity> m_ties;
+    std::vector<uint32_t> m_denseToSlot;
+
+    std::vector<uint32_t> m_slotToDense;
+    std::vector<uint32_t> m_slotGenerations;
+    std::vector<uint32_t> m_freeSlots;
+};
+
+/*
+    Particles don't exist in registry, they live in a pool per recipe
+    Spawning and expiration never create or destroy entities and never affect render layer order
+*/
 class ParticleSystem
 {
 public:
     ParticleSystem(entt::registry &reg_);
 
     template<IsComponentsView ViewT>
-    entt::entity makeParticle(const ParticleRecipe &particle_, const ViewT &view_);
+    ParticleHandle makeParticle(const ParticleRecipe &particle_, const ViewT &view_);
+
+    // Does nothing if particle already expired
+    void destroyParticle(const ParticleHandle &handle_);
 
     void update();
 
+    // Sorted by layer, from the furthest to the closest, same as the order of RenderLayer
+    const std::vector<const ParticlePool*> &getPoolsByDepth() const noexcept;
+
 private:
+    ParticlePool &getPool(const ParticleRecipe &particle_, uint32_t &poolId_);
+
     entt::registry &m_registry;
     AnimationManager &m_animmgmt;
 
+    std::vector<std::unique_ptr<ParticlePool>> m_pools;
+    std::vector<const ParticlePool*> m_poolsByDepth;
 };
@@ -4,53 +4,25 @@
 #include "Core/ECS/ComponentsView.hpp" // IWYU pragma: keep
 
 template<IsComponentsView ViewT>
-entt::entity ParticleSystem::makeParticle(const ParticleRecipe &particle_, const ViewT &view_)
+ParticleHandle ParticleSystem::makeParticle(const ParticleRecipe &particle_, const ViewT &view_)
 {
-    auto pid = m_registry.create();
+    uint32_t poolId = 0;
+    auto &pool = getPool(particle_, poolId);
     const auto &transEmitter = view_.template cget<ComponentTransform>();
 
     switch (particle_.tiePosRule)
     {
         case TiePosRule::TIE_TO_EMITTER:
-        {
-            auto offset = particle_.offset;
-
-            m_registry.emplace<ComponentTransform>(pid, offset, transEmitter.m_orientation);
-
-            auto &prim = m_registry.emplace<ComponentParticlePrimitive>(pid);
-            prim.lifetime.begin(particle_.lifetime);
-            prim.tieTransform = view_.entity();
-
-            auto &animrnd = m_registry.emplace<ComponentAnimationRenderable>(pid);
-            animrnd.loadAnimation(m_animmgmt, particle_.anim);
-            animrnd.m_currentAnimation = &animrnd.m_animations.at(particle_.anim);
-
-            m_registry.emplace<RenderLayer>(pid, particle_.layer);
-
-            break;
-        }
+            return pool.spawn(poolId, particle_.offset, transEmitter.m_orientation, particle_.lifetime, view_.entity());
 
         case TiePosRule::NONE:
+        default:
         {
             auto offset = particle_.offset;
             if (transEmitter.m_orientation == Orientation::LEFT)
                 offset.x *= -1;
 
-            m_registry.emplace<ComponentTransform>(pid, transEmitter.m_pos + offset, transEmitter.m_orientation);
-
-            auto &prim = m_registry.emplace<ComponentParticlePrimitive>(pid);
-            prim.lifetime.begin(particle_.lifetime);
-
-            auto &animrnd = m_registry.emplace<ComponentAnimationRenderable>(pid);
-            animrnd.loadAnimation(m_animmgmt, particle_.anim);
-            animrnd.m_currentAnimation = &animrnd.m_animations.at(particle_.anim);
-
-            m_registry.emplace<RenderLayer>(pid, particle_.layer);
-
-            break;
+            return pool.spawn(poolId, transEmitter.m_pos + offset, transEmitter.m_orientation, particle_.lifetime, entt::null);
         }
     }
-
-    return pid;
 }
-
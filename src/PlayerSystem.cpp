@@ -74,7 +74,7 @@ PlayerSystem::PlayerSystem(entt::registry &reg_, ParticleSystem &parSys_, Camera
 
             PlayerMake::RulePipe{}
                 .setDefaultPipe(PlayerStateProperties::Pipe::MultiplyVelocity{{0.2f, 1.f}},
-                                PlayerStateProperties::Pipe::DestroyParticlesOnLeave{m_reg},
+                                PlayerStateProperties::Pipe::DestroyParticlesOnLeave{m_parSys},
                                 PlayerStateProperties::Pipe::SetLookaheadSpeedSensitivity{})
                 .done(),
 
@@ -117,7 +117,7 @@ PlayerSystem::PlayerSystem(entt::registry &reg_, ParticleSystem &parSys_, Camera
 
             PlayerMake::RulePipe{}
                 .setDefaultPipe(PlayerStateProperties::Pipe::SetDemandWall{false},
-                                PlayerStateProperties::Pipe::DestroyParticlesOnLeave{m_reg})
+                                PlayerStateProperties::Pipe::DestroyParticlesOnLeave{m_parSys})
                 .done(),
 
             PlayerMake::RulePipe{}
@@ -185,7 +185,7 @@ PlayerSystem::PlayerSystem(entt::registry &reg_, ParticleSystem &parSys_, Camera
 
             PlayerMake::RulePipe{}
                 .setDefaultPipe(PlayerStateProperties::Pipe::MultiplyVelocity{{0.2f, 1.f}},
-                                PlayerStateProperties::Pipe::DestroyParticlesOnLeave{m_reg},
+                                PlayerStateProperties::Pipe::DestroyParticlesOnLeave{m_parSys},
                                 PlayerStateProperties::Pipe::SetInertiaApplicationMultiplier{{1.f, 1.f}},
                                 PlayerStateProperties::Pipe::SetLookaheadSpeedSensitivity{})
                 .done(),
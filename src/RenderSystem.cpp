@@ -6,12 +6,16 @@
 #include "Core/Configuration.h"
 #include "Core/Application.h"
 #include "Core/Logger.hpp"
+#include <algorithm>
+#include <cmath>
 
-RenderSystem::RenderSystem(entt::registry &reg_, Camera &camera_, ColliderRoutesCollection &rtCol_) :
+RenderSystem::RenderSystem(entt::registry &reg_, Camera &camera_, ColliderRoutesCollection &rtCol_, const ParticleSystem &partsys_) :
     m_reg(reg_),
     m_renderer(Application::instance().m_renderer),
     m_camera(camera_),
-    m_routesCollection(rtCol_)
+    m_routesCollection(rtCol_),
+    m_partsys(partsys_),
+    m_renderQueue(reg_)
 {
     subscribe(GAMEPLAY_EVENTS::REN_DBG_1);
     setInputEnabled();
@@ -19,13 +23,20 @@ RenderSystem::RenderSystem(entt::registry &reg_, Camera &camera_, ColliderRoutes
 
 void RenderSystem::update()
 {
-    auto rens = m_reg.view<ComponentAnimationRenderable>();
+    // Animations are evaluated when drawn, only the ones that have to stay on their frame are touched
+    Animation::advanceGlobalTick();
 
-    for (auto [idx, ren] : rens.each())
+    auto physRens = m_reg.view<ComponentPhysical, ComponentAnimationRenderable>();
+    for (auto [idx, phys, ren] : physRens.each())
     {
-        if (ren.m_currentAnimation && !checkCurrentHitstop(m_reg, idx))
-            ren.m_currentAnimation->update();
+        if (ren.m_currentAnimation && phys.hitstopLeft)
+            ren.m_currentAnimation->hold();
+    }
 
+    // Only battle actors get flashes from hits
+    auto actorRens = m_reg.view<BattleActor, ComponentAnimationRenderable>();
+    for (auto [idx, actor, ren] : actorRens.each())
+    {
         if (ren.m_flash)
         {
             if (ren.m_flash->update())
@@ -40,33 +51,37 @@ void RenderSystem::update()
     }
 }
 
-void RenderSystem::updateDepth()
-{
-    if (RenderLayer::m_dirtyOrder)
-    {
-        // FIXME: sometimes with a lot of enemies player can change layer
-        std::cout << "Updating depth" << std::endl;
-        m_reg.sort<RenderLayer>([](const RenderLayer &lhs_, const RenderLayer &rhs_)
-        {
-            return lhs_.getDepth() > rhs_.getDepth();
-        });
-    }
-
-    RenderLayer::m_dirtyOrder = false;
-}
-
 void RenderSystem::draw() const
 {
     const auto &conf = ConfigurationManager::instance();
+
+    // Same area Renderer maps to the world render target
+    m_viewRect = {m_camera.getPos() - Vector2<int>(gamedata::global::maxCameraSize) / 2, Vector2<int>(gamedata::global::maxCameraSize)};
+    m_stats = {};
+
     auto viewFocuses = m_reg.view<CameraFocusArea>();
     const auto viewTransforms = m_reg.view<ComponentTransform>();
     const auto viewHealthOwners = m_reg.view<ComponentTransform, HealthRendererCommonWRT>();
 
     const auto renderable = m_reg.view<RenderLayer, ComponentTransform>();
+    const auto &pools = m_partsys.getPoolsByDepth();
+    auto nextPool = pools.begin();
+
+    // Both sequences are sorted from the furthest to the closest, pools go before entities on the same layer
+    m_renderQueue.forEach([&](entt::entity idx_, int depth_) {
+        for (; nextPool != pools.end() && (*nextPool)->getLayer() >= depth_; ++nextPool)
+            drawParticles(**nextPool);
 
-    for (const auto &[idx, renlayer, trans] : renderable.each())
+        if (!renderable.contains(idx_))
+            return;
+
+        const auto &[renlayer, trans] = renderable.get(idx_);
         if (renlayer.isVisible())
-            handleDepthInstance(idx, trans);
+            handleDepthInstance(idx_, trans);
+    });
+
+    for (; nextPool != pools.end(); ++nextPool)
+        drawParticles(**nextPool);
 
     for (const auto &[idx, trans, hren] : viewHealthOwners.each())
         drawHealth(trans, hren);
@@ -80,6 +95,9 @@ void RenderSystem::draw() const
 
         for (const auto &[idx, scld] : viewColliders.each())
         {
+            if (!isInView(scld.m_resolved))
+                continue;
+
             if (scld.obstacleType > ObstacleType::NONE)
                 drawObstacle(scld);
             else
@@ -96,8 +114,10 @@ void RenderSystem::draw() const
         {
             const auto pbl = GrassTopComp::colliderLeft + trans.m_pos;
             const auto pbr = GrassTopComp::colliderRight + trans.m_pos;
-            m_renderer.drawCollider(pbl, {238, 195, 154, 50}, m_camera);
-            m_renderer.drawCollider(pbr, {238, 195, 154, 50}, m_camera);
+            if (isInView(pbl))
+                m_renderer.drawCollider(pbl, {238, 195, 154, 50}, m_camera);
+            if (isInView(pbr))
+                m_renderer.drawCollider(pbr, {238, 195, 154, 50}, m_camera);
         }
     }
 
@@ -139,6 +159,9 @@ void RenderSystem::drawInstance(const ComponentTransform &trans_, const Componen
             texPos.x -= animorigin.x;
         }
 
+        if (!checkSpriteVisible({texPos, texSize}))
+            return;
+
         auto spr = ren_.m_currentAnimation->getSprite();
 
         if (ren_.m_drawOutline)
@@ -161,25 +184,41 @@ void RenderSystem::drawInstance(const ComponentTransform &trans_, const Componen
     }
 }
 
-void RenderSystem::drawParticle(const ComponentTransform &trans_, const ComponentParticlePrimitive &partcl_, const ComponentAnimationRenderable &ren_) const
+void RenderSystem::drawParticles(const ParticlePool &pool_) const
 {
-    if (ren_.m_currentAnimation != nullptr)
+    if (pool_.size() == 0)
+        return;
+
+    const auto &textures = pool_.getTextures();
+    const Vector2<int> texSize{textures.m_w, textures.m_h};
+    const auto animorigin = textures.m_origin;
+    const bool tied = pool_.getTiePosRule() == TiePosRule::TIE_TO_EMITTER;
+    const bool drawDebug = ConfigurationManager::instance().m_debug.m_drawDebugTextures;
+
+    const auto &positions = pool_.getPositions();
+    const auto &orientations = pool_.getOrientations();
+    const auto &angles = pool_.getAngles();
+    const auto &ties = pool_.getTies();
+
+    for (size_t i = 0; i < pool_.size(); ++i)
     {
-        const auto texSize = ren_.m_currentAnimation->getSize();
-        const auto animorigin = ren_.m_currentAnimation->getOrigin();
-        auto texPos = trans_.m_pos;
-        if (partcl_.tieTransform != entt::null)
+        auto texPos = positions[i];
+        if (tied)
         {
-            const auto &tiedTrans = m_reg.get<ComponentTransform>(partcl_.tieTransform);
-            if (tiedTrans.m_orientation == Orientation::LEFT)
-                texPos = tiedTrans.m_pos.add(-texPos.x, texPos.y);
+            // Emitter might have been destroyed after particles were updated this frame
+            const auto *tiedTrans = m_reg.try_get<ComponentTransform>(ties[i]);
+            if (!tiedTrans)
+                continue;
+
+            if (tiedTrans->m_orientation == Orientation::LEFT)
+                texPos = tiedTrans->m_pos.add(-texPos.x, texPos.y);
             else
-                texPos = tiedTrans.m_pos.add(texPos.x, texPos.y);
+                texPos = tiedTrans->m_pos.add(texPos.x, texPos.y);
         }
 
         SDL_FlipMode flip = SDL_FLIP_NONE;
 
-        if (trans_.m_orientation == Orientation::LEFT)
+        if (orientations[i] == Orientation::LEFT)
         {
             texPos.x -= (texSize.x - animorigin.x) - 2;
             flip = SDL_FLIP_HORIZONTAL;
@@ -189,11 +228,12 @@ void RenderSystem::drawParticle(const ComponentTransform &trans_, const Componen
 
         texPos.y -= animorigin.y;
 
-        const auto spr = ren_.m_currentAnimation->getSprite();
+        if (!checkSpriteVisible({texPos, texSize}))
+            continue;
 
-        m_renderer.renderTexture(spr, texPos, texSize, flip, partcl_.angle, animorigin, m_camera);
+        m_renderer.renderTexture(textures[pool_.getFrame(i)], texPos, texSize, flip, angles[i], animorigin, m_camera);
 
-        if (ConfigurationManager::instance().m_debug.m_drawDebugTextures)
+        if (drawDebug)
         {
             m_renderer.drawRectangle(texPos, texSize, {100, 0, 100, 255}, m_camera);
             m_renderer.fillRectangle(texPos + animorigin - Vector2{2, 2}, {5, 5}, {100, 0, 100, 255}, m_camera);
@@ -205,44 +245,87 @@ void RenderSystem::drawTilemapLayer(const ComponentTransform &trans_, const Tile
 {
     const Vector2<int> camTL = Vector2<int>(m_camera.getPos().mulComponents(tilemap_.m_parallaxFactor)) - Vector2<int>(gamedata::global::maxCameraSize) / 2;
 
+    const Vector2<int> tileSize = gamedata::tiles::tileSize;
+    const Vector2<int> targetSize = gamedata::global::maxCameraSize;
+    const Vector2<int> origin = trans_.m_pos + tilemap_.m_posOffset - camTL;
+
+    // Only rows and columns that overlap the render target after parallax shift
+    const auto firstVisible = [](int origin_, int tileSize_) {
+        return (origin_ < 0 ? -origin_ / tileSize_ : 0);
+    };
+
+    const auto rowCount = static_cast<int>(tilemap_.m_tiles.size());
+    const auto firstRow = firstVisible(origin.y, tileSize.y);
+    const auto lastRow = std::min(rowCount, (targetSize.y - origin.y + tileSize.y - 1) / tileSize.y);
+    const auto firstColumn = firstVisible(origin.x, tileSize.x);
+
     Vector2<int> dstPos;
-    dstPos.x = trans_.m_pos.x + tilemap_.m_posOffset.x - camTL.x;
-    dstPos.y = trans_.m_pos.y + tilemap_.m_posOffset.y - camTL.y;
+    dstPos.y = origin.y + firstRow * tileSize.y;
 
+    uint32_t totalTiles = 0;
     for (const auto &row : tilemap_.m_tiles)
+        totalTiles += static_cast<uint32_t>(row.size());
+
+    uint32_t visitedTiles = 0;
+    for (int y = firstRow; y < lastRow; ++y)
     {
-        dstPos.x = trans_.m_pos.x + tilemap_.m_posOffset.x - camTL.x;
-        for (const auto &tile : row)
+        const auto &row = tilemap_.m_tiles[y];
+        const auto lastColumn = std::min(static_cast<int>(row.size()), (targetSize.x - origin.x + tileSize.x - 1) / tileSize.x);
+
+        dstPos.x = origin.x + firstColumn * tileSize.x;
+        for (int x = firstColumn; x < lastColumn; ++x)
         {
+            const auto &tile = row[x];
             if (tile.m_tile)
             {
-                m_renderer.renderTile(tile.m_tile->m_tex, dstPos, gamedata::tiles::tileSize, tile.m_flip, tile.m_tile->m_tilePos);
+                m_renderer.renderTile(tile.m_tile->m_tex, dstPos, tileSize, tile.m_flip, tile.m_tile->m_tilePos);
+                m_stats.m_tilesDrawn++;
             }
-            dstPos.x += gamedata::tiles::tileSize.x;
+
+            visitedTiles++;
+            dstPos.x += tileSize.x;
         }
-        dstPos.y += gamedata::tiles::tileSize.y;
+        dstPos.y += tileSize.y;
     }
+
+    m_stats.m_tilesCulled += totalTiles - visitedTiles;
 }
 
-void RenderSystem::handleDepthInstance(const entt::entity &idx_, const ComponentTransform &trans_) const
+void RenderSystem::drawPropSet(const PropSet &props_) const
 {
-    if (auto *ren = m_reg.try_get<ComponentAnimationRenderable>(idx_))
+    const auto &batches = props_.buildBatches(m_viewRect);
+    const auto &positions = props_.getBatchPositions();
+
+    for (const auto &batch : batches)
+        m_renderer.renderTextureInstanced(batch.m_texture, positions.data() + batch.m_first, batch.m_count, batch.m_size, SDL_FLIP_NONE, m_camera);
+
+    m_stats.m_drawn += static_cast<uint32_t>(positions.size());
+    m_stats.m_culled += props_.getCulledCount();
+
+    if (ConfigurationManager::instance().m_debug.m_drawDebugTextures)
     {
-        if (auto *partcl = m_reg.try_get<ComponentParticlePrimitive>(idx_))
-        {
-            // Definitely particle
-            drawParticle(trans_, *partcl, *ren);
-        }
-        else
+        for (const auto &batch : batches)
         {
-            // Definitely instance
-            drawInstance(trans_, *ren);
+            for (auto i = batch.m_first; i < batch.m_first + batch.m_count; ++i)
+                m_renderer.drawRectangle(Vector2<int>(positions[i]), batch.m_size, {100, 0, 100, 255}, m_camera);
         }
     }
+}
+
+void RenderSystem::handleDepthInstance(const entt::entity &idx_, const ComponentTransform &trans_) const
+{
+    if (auto *ren = m_reg.try_get<ComponentAnimationRenderable>(idx_))
+    {
+        drawInstance(trans_, *ren);
+    }
     else if (auto *tilemap = m_reg.try_get<TilemapLayer>(idx_))
     {
         drawTilemapLayer(trans_, *tilemap);
     }
+    else if (auto *props = m_reg.try_get<PropSet>(idx_))
+    {
+        drawPropSet(*props);
+    }
 }
 
 void RenderSystem::drawBattleActorColliders(const ComponentTransform &trans_, const BattleActor &btlact_) const
@@ -255,7 +338,9 @@ void RenderSystem::drawBattleActorColliders(const ComponentTransform &trans_, co
             {
                 if (tcld.m_timeline[btlact_.m_currentFrame])
                 {
-                    m_renderer.drawCollider(getColliderAt(tcld.m_collider, trans_), gamedata::characters::hurtboxColor, m_camera);
+                    const auto cld = getColliderAt(tcld.m_collider, trans_);
+                    if (isInView(cld))
+                        m_renderer.drawCollider(cld, gamedata::characters::hurtboxColor, m_camera);
                 }
             }
         }
@@ -265,8 +350,12 @@ void RenderSystem::drawBattleActorColliders(const ComponentTransform &trans_, co
     {
         for (const auto &tmpcld : hit->m_colliders)
         {
-            if (tmpcld.m_timeline[btlact_.m_currentFrame])
-                m_renderer.drawCollider(getColliderAt(tmpcld.m_collider, trans_), gamedata::characters::hitboxColor, m_camera);
+            if (!tmpcld.m_timeline[btlact_.m_currentFrame])
+                continue;
+
+            const auto cld = getColliderAt(tmpcld.m_collider, trans_);
+            if (isInView(cld))
+                m_renderer.drawCollider(cld, gamedata::characters::hitboxColor, m_camera);
         }
     }
 }
@@ -274,6 +363,9 @@ void RenderSystem::drawBattleActorColliders(const ComponentTransform &trans_, co
 void RenderSystem::drawCollider(const ComponentTransform &trans_, const ComponentPhysical &phys_) const
 {
     auto pb = phys_.pushbox + trans_.m_pos;
+    if (!isInView(pb))
+        return;
+
     m_renderer.drawCollider(pb, gamedata::characters::pushboxColor, m_camera);
 
     auto edgex = (trans_.m_orientation == Orientation::RIGHT ? pb.getRightEdge() + 1 : 
@@ -324,6 +416,15 @@ void RenderSystem::drawHealth(const ComponentTransform &trans_, const  HealthRen
     const auto texCenter = (worldPos - animorigin).sub(0, texSize.y - 20);
 
     const float mid = (float)(howner_.m_heartAnims.size() - 1) / 2.0f;
+
+    const auto heartStep = texSize.x - 19;
+    const Collider bounds{
+        {texCenter.x - static_cast<int>(std::ceil(std::abs(heartStep) * mid)), texCenter.y},
+        {std::abs(heartStep) * static_cast<int>(howner_.m_heartAnims.size() - 1) + texSize.x, texSize.y}
+    };
+
+    if (!checkSpriteVisible(bounds))
+        return;
     float cnt = 0;
 
     for (const auto &el : howner_.m_heartAnims)
@@ -372,6 +473,34 @@ void RenderSystem::drawColliderRoute(const ColliderPointRouting &route_) const
     }
 }
 
+bool RenderSystem::isInView(const Collider &bounds_) const noexcept
+{
+    return (m_viewRect.checkOverlap(bounds_) & OverlapResult::OVERLAP_BOTH) == OverlapResult::OVERLAP_BOTH;
+}
+
+bool RenderSystem::isInView(const SlopeCollider &cld_) const noexcept
+{
+    const auto top = std::min(cld_.leftY(), cld_.rightY());
+    return isInView(Collider{{cld_.leftX(), top}, {cld_.rightX() - cld_.leftX() + 1, cld_.bottomY() - top + 1}});
+}
+
+bool RenderSystem::checkSpriteVisible(const Collider &bounds_) const noexcept
+{
+    if (isInView(bounds_))
+    {
+        m_stats.m_drawn++;
+        return true;
+    }
+
+    m_stats.m_culled++;
+    return false;
+}
+
+const RenderStats &RenderSystem::getStats() const noexcept
+{
+    return m_stats;
+}
+
 void RenderSystem::receiveEvents(GAMEPLAY_EVENTS event_, const float scale_)
 {
     switch (event_)
@@ -1,22 +1,36 @@
 #pragma once
 #include "Hit.h"
+#include "ParticleSystem.h"
 #include "Core/InputSystem.h"
 #include "Core/CoreComponents.h"
 #include "Core/CameraFocusArea.h"
+#include "Core/RenderQueue.h"
+#include "Core/PropSet.h"
 #include "Physics/ColliderRouting.h"
 #include <entt/entt.hpp>
 
+// What got to the renderer during the last draw, collected for the HUD
+struct RenderStats
+{
+    uint32_t m_drawn = 0;
+    uint32_t m_culled = 0;
+    uint32_t m_tilesDrawn = 0;
+
+    // Tilemap cells outside of the view, including empty ones
+    uint32_t m_tilesCulled = 0;
+};
+
 struct RenderSystem : public InputReactor
 {
-    RenderSystem(entt::registry &reg_, Camera &camera_, ColliderRoutesCollection &rtCol_);
+    RenderSystem(entt::registry &reg_, Camera &camera_, ColliderRoutesCollection &rtCol_, const ParticleSystem &partsys_);
 
     void update();
-    void updateDepth();
     void draw() const;
 
     void drawInstance(const ComponentTransform &trans_, const ComponentAnimationRenderable &ren_) const;
-    void drawParticle(const ComponentTransform &trans_, const ComponentParticlePrimitive &partcl_, const ComponentAnimationRenderable &ren_) const;
+    void drawParticles(const ParticlePool &pool_) const;
     void drawTilemapLayer(const ComponentTransform &trans_, const TilemapLayer &tilemap_) const;
+    void drawPropSet(const PropSet &props_) const;
 
     void handleDepthInstance(const entt::entity &idx_, const ComponentTransform &trans_) const;
 
@@ -31,10 +45,24 @@ struct RenderSystem : public InputReactor
 
     void drawColliderRoute(const ColliderPointRouting &route_) const;
 
+    // Bounds in world coordinates, anything outside of world render target is skipped before reaching the renderer
+    bool isInView(const Collider &bounds_) const noexcept;
+    bool isInView(const SlopeCollider &cld_) const noexcept;
+
+    // Counts bounds_ as drawn or culled sprite
+    bool checkSpriteVisible(const Collider &bounds_) const noexcept;
+
+    const RenderStats &getStats() const noexcept;
+
     void receiveEvents(GAMEPLAY_EVENTS event_, float scale_) override;
 
     entt::registry &m_reg;
     Renderer &m_renderer;
     Camera &m_camera;
     ColliderRoutesCollection &m_routesCollection;
+    const ParticleSystem &m_partsys;
+    RenderQueue m_renderQueue;
+
+    mutable Collider m_viewRect;
+    mutable RenderStats m_stats;
 };
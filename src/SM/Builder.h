@@ -1,5 +1,6 @@
 #pragma once
 #include "CompoundState.h"
+#include "StaticStateMachine.h"
 #include "TransitionChecks.h"
 
 namespace SM
@@ -12,6 +13,13 @@ public:
     template<typename... Args>
     static std::unique_ptr<SM::CompoundState<StateIDT, ViewT, Args...>> state(StateIDT id_, Args&&... args_);
 
+    // Same arguments as for state, but returns a state for StaticStateMachine
+    template<typename... Args>
+    static SM::StaticState<StateIDT, ViewT, Args...> staticState(StateIDT id_, Args&&... args_);
+
+    template<typename... StatesT>
+    static SM::StaticStateMachine<StateIDT, ViewT, StatesT...> staticMachine(StatesT&&... states_);
+
     class RulePipe
     {
     public:
@@ -1,6 +1,7 @@
 #pragma once
 #include "SM/Builder.h"
 #include "SM/CompoundState.hpp"
+#include "SM/StaticStateMachine.hpp"
 #include "SM/TransitionChecks.hpp"
 
 namespace SM
@@ -13,6 +14,20 @@ namespace SM
         return std::make_unique<SM::CompoundState<StateIDT, ViewT, Args...>>(id_, std::forward<Args>(args_)...);
     }
 
+    template<typename StateIDT, typename ViewT>
+    template<typename... Args>
+    SM::StaticState<StateIDT, ViewT, Args...> Make<StateIDT, ViewT>::staticState(StateIDT id_, Args&&... args_)
+    {
+        return SM::StaticState<StateIDT, ViewT, Args...>(id_, std::forward<Args>(args_)...);
+    }
+
+    template<typename StateIDT, typename ViewT>
+    template<typename... StatesT>
+    SM::StaticStateMachine<StateIDT, ViewT, StatesT...> Make<StateIDT, ViewT>::staticMachine(StatesT&&... states_)
+    {
+        return SM::StaticStateMachine<StateIDT, ViewT, StatesT...>(std::forward<StatesT>(states_)...);
+    }
+
     template<typename StateIDT, typename ViewT>
     SM::RulePipesContainer<StateIDT, ViewT> &&Make<StateIDT, ViewT>::RulePipe::done()
     {
@@ -5,7 +5,7 @@
 #include "entt/entity/fwd.hpp"
 #include "Core/ECS/ComponentsView.h"
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
 enum class TraverseTraits : Traverse::TraitT {
     WALK = 0b001,
@@ -78,8 +78,27 @@ namespace SM
         const StateIDT m_id;
     };
 
+    /**
+     * Describes what a state's updater is allowed to touch, only matters for StateMachine::updateBucketed
+     */
+    enum class UpdateLocality : uint8_t
+    {
+        // Updater might touch registry or anything shared (particles, camera, etc), entities are updated one by one
+        SHARED,
+
+        // Updater only writes components of the entity it updates, so entities in the same state can be updated in parallel
+        ENTITY_LOCAL
+    };
+
+    /**
+     * Entities grouped by state for StateMachine::updateBucketed, owned by the caller so the machine itself stays immutable
+     * Keep one per caller between frames to avoid reallocations
+     */
+    using StateBuckets = std::vector<std::vector<entt::entity>>;
+
     /**
      *  A new shiny flexible state machine. Completely immutable, stored as a single instance in the respective system
+     *  States are stored in a dense table indexed by state ID, so lookup is a single indexing
      */
     template<typename StateIDT, IsComponentsView ViewT>
     class StateMachine
@@ -91,13 +110,26 @@ namespace SM
         StateMachine(StateMachine&&) noexcept = default;
         StateMachine &operator=(StateMachine&&) noexcept = default;
 
-        void addState(std::unique_ptr<GenericState<StateIDT, ViewT>> &&newState_);
+        void addState(std::unique_ptr<GenericState<StateIDT, ViewT>> &&newState_, UpdateLocality locality_ = UpdateLocality::SHARED);
 
         void init(entt::registry &reg_, entt::entity idx_);
         void update(entt::registry &reg_) const;
 
+        /*
+            Alternative to update for large amounts of entities:
+            1. Entities are grouped by current state
+            2. Each state updates its whole group at once, in parallel if the state is ENTITY_LOCAL,
+               such updaters must only touch components of their own entity, debug builds check that no entities were created or destroyed
+            3. Transitions are checked and applied sequentially, in order of state IDs and then storage order
+            Unlike update, all entities are updated before any transition is handled
+        */
+        void updateBucketed(entt::registry &reg_, StateBuckets &buckets_) const;
+
     private:
-        std::unordered_map<StateIDT, std::unique_ptr<GenericState<StateIDT, ViewT>>> m_states;
+        const GenericState<StateIDT, ViewT> &getState(StateIDT id_) const;
+
+        std::vector<std::unique_ptr<GenericState<StateIDT, ViewT>>> m_states;
+        std::vector<UpdateLocality> m_localities;
     };
 
 }
@@ -3,6 +3,9 @@
 #include "Core/Vector2.hpp"
 #include "StateMachine.h"
 #include <entt/entt.hpp>
+#include <algorithm>
+#include <cassert>
+#include <execution>
 #include <stdexcept>
 
 namespace SM
@@ -52,15 +55,33 @@ namespace SM
     }
 
     template<typename StateIDT, IsComponentsView ViewT>
-    void StateMachine<StateIDT, ViewT>::addState(std::unique_ptr<GenericState<StateIDT, ViewT>> &&newState_)
+    void StateMachine<StateIDT, ViewT>::addState(std::unique_ptr<GenericState<StateIDT, ViewT>> &&newState_, UpdateLocality locality_)
     {
         if (!newState_)
             throw std::runtime_error("Trying to add nullptr state");
 
-        if (m_states.contains(newState_->id()))
+        const auto idx = static_cast<size_t>(newState_->id());
+        if (idx >= m_states.size())
+        {
+            m_states.resize(idx + 1);
+            m_localities.resize(idx + 1, UpdateLocality::SHARED);
+        }
+
+        if (m_states[idx])
             throw std::runtime_error(std::format("State machine already contains state {}", serialize(newState_->id())));
 
-        m_states[newState_->id()] = std::move(newState_);
+        m_states[idx] = std::move(newState_);
+        m_localities[idx] = locality_;
+    }
+
+    template<typename StateIDT, IsComponentsView ViewT>
+    const GenericState<StateIDT, ViewT> &StateMachine<StateIDT, ViewT>::getState(StateIDT id_) const
+    {
+        const auto idx = static_cast<size_t>(id_);
+        if (idx >= m_states.size() || !m_states[idx])
+            throw std::runtime_error(std::format("State machine does not contain state {}", serialize(id_)));
+
+        return *m_states[idx];
     }
 
     template<typename StateIDT, IsComponentsView ViewT>
@@ -68,7 +89,7 @@ namespace SM
     {
         const auto &possessor = reg_.get<StatePossessor<StateIDT>>(idx_);
         const auto &transform = reg_.get<ComponentTransform>(idx_);
-        const GenericState<StateIDT, ViewT> &state = *m_states.at(possessor.stateId());
+        const GenericState<StateIDT, ViewT> &state = getState(possessor.stateId());
 
         const auto refs = ViewT::makeRefs(reg_, idx_);
         ViewT view{refs};
@@ -83,14 +104,14 @@ namespace SM
         {
             ViewT entityView{ent};
             const StatePossessor<StateIDT> &possessor = entityView.template cget<StatePossessor<StateIDT>>();
-            const GenericState<StateIDT, ViewT> *state = m_states.at(possessor.stateId()).get();
+            const GenericState<StateIDT, ViewT> *state = &getState(possessor.stateId());
             state->update(entityView);
             
             TransitionData transition = state->canTransition(entityView);
 
             while (transition.intoOrientation != 0)
             {
-                const auto &newState = *m_states.at(transition.intoState);
+                const auto &newState = getState(transition.intoState);
                 state->handleTransitionFrom(entityView, transition);
                 newState.handleTransitionInto(entityView, transition);
                 state = &newState;
@@ -98,4 +119,79 @@ namespace SM
             }
         }
     }
+
+    template<typename StateIDT, IsComponentsView ViewT>
+    void StateMachine<StateIDT, ViewT>::updateBucketed(entt::registry &reg_, StateBuckets &buckets_) const
+    {
+        buckets_.resize(m_states.size());
+        for (auto &bucket : buckets_)
+            bucket.clear();
+
+        auto view = ViewT::makeView(reg_);
+        for (const auto &ent : view.each())
+        {
+            const auto stateIdx = static_cast<size_t>(std::get<StatePossessor<StateIDT>&>(ent).stateId());
+            if (stateIdx >= buckets_.size())
+                throw std::runtime_error(std::format("State machine does not contain state {}", serialize(std::get<StatePossessor<StateIDT>&>(ent).stateId())));
+
+            buckets_[stateIdx].emplace_back(std::get<entt::entity>(ent));
+        }
+
+        /*
+            Only references are fetched per entity since SHARED updaters are allowed to create entities and invalidate storages
+            ENTITY_LOCAL updaters run in parallel, so they must only touch components of their own entity and never create or destroy anything
+        */
+        const auto updateEntity = [&reg_](const GenericState<StateIDT, ViewT> &state_, entt::entity idx_) {
+            const auto refs = ViewT::makeRefs(reg_, idx_);
+            state_.update(ViewT{refs});
+        };
+
+        for (size_t i = 0; i < buckets_.size(); ++i)
+        {
+            const auto &bucket = buckets_[i];
+            if (bucket.empty())
+                continue;
+
+            const auto &state = getState(static_cast<StateIDT>(i));
+            if (m_localities[i] == UpdateLocality::ENTITY_LOCAL)
+            {
+#ifndef NDEBUG
+                // Catches the most common violation of ENTITY_LOCAL, spawning or destroying entities from an updater
+                const auto countEntities = [&reg_]() {
+                    size_t res = 0;
+                    for ([[maybe_unused]] const auto &ent : ViewT::makeView(reg_).each())
+                        res++;
+                    return res;
+                };
+                const auto entitiesBefore = countEntities();
+#endif
+
+                std::for_each(std::execution::par, bucket.begin(), bucket.end(), [&](entt::entity idx_) { updateEntity(state, idx_); });
+
+                assert(countEntities() == entitiesBefore && "ENTITY_LOCAL updater created or destroyed entities");
+            }
+            else
+                std::for_each(bucket.begin(), bucket.end(), [&](entt::entity idx_) { updateEntity(state, idx_); });
+        }
+
+        for (size_t i = 0; i < buckets_.size(); ++i)
+        {
+            for (auto idx : buckets_[i])
+            {
+                const auto refs = ViewT::makeRefs(reg_, idx);
+                ViewT entityView{refs};
+                const GenericState<StateIDT, ViewT> *state = &getState(static_cast<StateIDT>(i));
+                TransitionData transition = state->canTransition(entityView);
+
+                while (transition.intoOrientation != 0)
+                {
+                    const auto &newState = getState(transition.intoState);
+                    state->handleTransitionFrom(entityView, transition);
+                    newState.handleTransitionInto(entityView, transition);
+                    state = &newState;
+                    transition = newState.canTransition(entityView);
+                }
+            }
+        }
+    }
 } // SM
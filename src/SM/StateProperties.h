@@ -382,12 +382,12 @@ struct StateProperties
         class DestroyParticlesOnLeave
         {
         public:
-            DestroyParticlesOnLeave(entt::registry &reg_);
+            DestroyParticlesOnLeave(ParticleSystem &parSys_);
 
             void operator()(const ViewT&, const SM::TransitionData<StateIDT> &transition_) const;
         
         private:
-            entt::registry &m_reg;
+            ParticleSystem &m_parSys;
         };
     };
 };
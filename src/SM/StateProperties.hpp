@@ -446,37 +446,37 @@ void StateProperties<StateIDT, ViewT>::Pipe::LeaveWallPrejump::operator()(const
     const size_t lookAt = std::min(inputs.getFilled() - 1, static_cast<size_t>(gamedata::global::inputBufferLength) * 2);
     for (size_t i = 0; i <= lookAt; ++i)
     {
-        const auto &in = inputs[i];
+        const auto dir = inputs[i].getDir();
 
-        if (in.m_dir == Vector2{0, -1})
+        if (dir == Vector2{0, -1})
         {
             targetSpeed = {orient * 0.7f, -5.0f};
             fall = false;
             break;
         }
 
-        if (in.m_dir == Vector2{orient, -1})
+        if (dir == Vector2{orient, -1})
         {
             targetSpeed = {orient * 1.5f, -4.5f};
             fall = false;
             break;
         }
 
-        if (in.m_dir == Vector2{orient, 0})
+        if (dir == Vector2{orient, 0})
         {
             targetSpeed = {orient * 3.0f, -2.2f};
             fall = false;
             break;
         }
 
-        if (in.m_dir == Vector2{orient, 1})
+        if (dir == Vector2{orient, 1})
         {
             targetSpeed = {orient * 3.5f, 0.0f};
             fall = false;
             break;
         }
 
-        if (in.m_dir == Vector2{orient, 1})
+        if (dir == Vector2{orient, 1})
         {
             break;
         }
@@ -517,8 +517,8 @@ void StateProperties<StateIDT, ViewT>::Pipe::CamShake::operator()(const ViewT&,
 
 
 template<typename StateIDT, typename ViewT>
-StateProperties<StateIDT, ViewT>::Pipe::DestroyParticlesOnLeave::DestroyParticlesOnLeave(entt::registry &reg_) :
-    m_reg{reg_}
+StateProperties<StateIDT, ViewT>::Pipe::DestroyParticlesOnLeave::DestroyParticlesOnLeave(ParticleSystem &parSys_) :
+    m_parSys{parSys_}
 {}
 
 template<typename StateIDT, typename ViewT>
@@ -527,10 +527,7 @@ void StateProperties<StateIDT, ViewT>::Pipe::DestroyParticlesOnLeave::operator()
     auto &particles = view_.template get<ComponentChildParticles>().destroyOnStateChange;
     
     for (const auto &el : particles)
-    {
-        if (m_reg.valid(el))
-            m_reg.destroy(el);
-    }
+        m_parSys.destroyParticle(el);
 
     particles.clear();
 }
@@ -0,0 +1,68 @@
+#pragma once
+#include "StateMachine.h"
+#include <tuple>
+#include <vector>
+
+namespace SM
+{
+    /**
+     * Same as CompoundState, but without an interface - all callables are known at compile time and can be inlined.
+     * Only usable with StaticStateMachine. Since there is no interface, RulePipesContainer is not required for handlers -
+     * CallBatch or any other callable taking (view, transition) will do
+     */
+    template<typename StateIDT, typename ViewT, typename UpdaterT, typename TransCheckT, typename HandlerFromT, typename HandlerIntoT>
+    class StaticState
+    {
+    public:
+        StaticState(const StateIDT &id_, UpdaterT &&updater_, TransCheckT &&transCheck_, HandlerFromT &&handlerFrom_, HandlerIntoT &&handlerTo_);
+        StaticState(StaticState &&) noexcept = default;
+        StaticState &operator=(StaticState &&) noexcept = default;
+
+        StateIDT id() const noexcept { return m_id; };
+        void update(const ViewT &view_) const;
+        TransitionData<StateIDT> canTransition(const ViewT &view_) const;
+        void handleTransitionFrom(const ViewT &view_, const TransitionData<StateIDT>& transition_) const;
+        void handleTransitionInto(const ViewT &view_, const TransitionData<StateIDT>& transition_) const;
+
+    private:
+        StateIDT m_id;
+        UpdaterT m_updater;
+        TransCheckT m_transitionCheck;
+        HandlerFromT m_transitionFromHandler;
+        HandlerIntoT m_transitionIntoHandler;
+    };
+
+    /**
+     *  Fully static counterpart of StateMachine - states are stored by value in a tuple, current state is resolved
+     *  through a dense table of tuple indices and dispatched without virtual calls.
+     *  Same update logic as in StateMachine, the set of states must be known at compile time
+     */
+    template<typename StateIDT, IsComponentsView ViewT, typename... StatesT>
+    class StaticStateMachine
+    {
+    public:
+        StaticStateMachine(StatesT&&... states_);
+        StaticStateMachine(const StaticStateMachine&) = delete;
+        StaticStateMachine &operator=(const StaticStateMachine&) = delete;
+        StaticStateMachine(StaticStateMachine&&) noexcept = default;
+        StaticStateMachine &operator=(StaticStateMachine&&) noexcept = default;
+
+        void init(entt::registry &reg_, entt::entity idx_) const;
+        void update(entt::registry &reg_) const;
+
+    private:
+        template<typename FuncT>
+        void visit(StateIDT id_, FuncT &&func_) const;
+
+        template<typename FuncT, size_t... Is>
+        void visitImpl(uint8_t tupleIdx_, FuncT &&func_, std::index_sequence<Is...>) const;
+
+        static constexpr uint8_t NO_STATE = 0xff;
+        static_assert(sizeof...(StatesT) < NO_STATE, "Too many states for a static state machine");
+
+        std::tuple<StatesT...> m_states;
+
+        // State ID => index in m_states
+        std::vector<uint8_t> m_tupleIndices;
+    };
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include "StaticStateMachine.h"
+#include "StateMachine.hpp"
+#include "Core/Logger.hpp"
+#include <stdexcept>
+
+namespace SM
+{
+    template<typename StateIDT, typename ViewT, typename UpdaterT, typename TransCheckT, typename HandlerFromT, typename HandlerIntoT>
+    StaticState<StateIDT, ViewT, UpdaterT, TransCheckT, HandlerFromT, HandlerIntoT>
+        ::StaticState(const StateIDT &id_, UpdaterT &&updater_, TransCheckT &&transCheck_, HandlerFromT &&handlerFrom_, HandlerIntoT &&handlerTo_) :
+        m_id{id_},
+        m_updater{std::move(updater_)},
+        m_transitionCheck{std::move(transCheck_)},
+        m_transitionFromHandler{std::move(handlerFrom_)},
+        m_transitionIntoHandler{std::move(handlerTo_)}
+    {
+    }
+
+    template<typename StateIDT, typename ViewT, typename UpdaterT, typename TransCheckT, typename HandlerFromT, typename HandlerIntoT>
+    void StaticState<StateIDT, ViewT, UpdaterT, TransCheckT, HandlerFromT, HandlerIntoT>::update(const ViewT &view_) const
+    {
+        m_updater(view_);
+        view_.template get<StatePossessor<StateIDT>>().addFrameInState();
+    }
+
+    template<typename StateIDT, typename ViewT, typename UpdaterT, typename TransCheckT, typename HandlerFromT, typename HandlerIntoT>
+    TransitionData<StateIDT> StaticState<StateIDT, ViewT, UpdaterT, TransCheckT, HandlerFromT, HandlerIntoT>::canTransition(const ViewT &view_) const
+    {
+        auto res = m_transitionCheck(view_);
+        res.fromState = m_id;
+        if (res.intoOrientation != 0)
+            LOG_TRACE("{} => {} ({})", serialize(res.fromState), serialize(res.intoState), res.intoOrientation);
+        return res;
+    }
+
+    template<typename StateIDT, typename ViewT, typename UpdaterT, typename TransCheckT, typename HandlerFromT, typename HandlerIntoT>
+    void StaticState<StateIDT, ViewT, UpdaterT, TransCheckT, HandlerFromT, HandlerIntoT>::handleTransitionFrom(const ViewT &view_, const TransitionData<StateIDT>& transition_) const
+    {
+        m_transitionFromHandler(view_, transition_);
+    }
+
+    template<typename StateIDT, typename ViewT, typename UpdaterT, typename TransCheckT, typename HandlerFromT, typename HandlerIntoT>
+    void StaticState<StateIDT, ViewT, UpdaterT, TransCheckT, HandlerFromT, HandlerIntoT>::handleTransitionInto(const ViewT &view_, const TransitionData<StateIDT>& transition_) const
+    {
+        m_transitionIntoHandler(view_, transition_);
+        view_.template get<StatePossessor<StateIDT>>().setState(m_id);
+    }
+
+
+    template<typename StateIDT, IsComponentsView ViewT, typename... StatesT>
+    StaticStateMachine<StateIDT, ViewT, StatesT...>::StaticStateMachine(StatesT&&... states_) :
+        m_states(std::move(states_)...)
+    {
+        const auto addIndex = [this](StateIDT id_, uint8_t tupleIdx_) {
+            const auto idx = static_cast<size_t>(id_);
+            if (idx >= m_tupleIndices.size())
+                m_tupleIndices.resize(idx + 1, NO_STATE);
+
+            if (m_tupleIndices[idx] != NO_STATE)
+                throw std::runtime_error(std::format("State machine already contains state {}", serialize(id_)));
+
+            m_tupleIndices[idx] = tupleIdx_;
+        };
+
+        uint8_t tupleIdx = 0;
+        std::apply([&](const auto&... state_) {
+            (addIndex(state_.id(), tupleIdx++), ...);
+        }, m_states);
+    }
+
+    template<typename StateIDT, IsComponentsView ViewT, typename... StatesT>
+    template<typename FuncT>
+    void StaticStateMachine<StateIDT, ViewT, StatesT...>::visit(StateIDT id_, FuncT &&func_) const
+    {
+        const auto idx = static_cast<size_t>(id_);
+        if (idx >= m_tupleIndices.size() || m_tupleIndices[idx] == NO_STATE)
+            throw std::runtime_error(std::format("State machine does not contain state {}", serialize(id_)));
+
+        visitImpl(m_tupleIndices[idx], std::forward<FuncT>(func_), std::index_sequence_for<StatesT...>{});
+    }
+
+    template<typename StateIDT, IsComponentsView ViewT, typename... StatesT>
+    template<typename FuncT, size_t... Is>
+    void StaticStateMachine<StateIDT, ViewT, StatesT...>::visitImpl(uint8_t tupleIdx_, FuncT &&func_, std::index_sequence<Is...>) const
+    {
+        // Usually gets compiled into a jump table
+        ((tupleIdx_ == Is ? (func_(std::get<Is>(m_states)), true) : false) || ...);
+    }
+
+    template<typename StateIDT, IsComponentsView ViewT, typename... StatesT>
+    void StaticStateMachine<StateIDT, ViewT, StatesT...>::init(entt::registry &reg_, entt::entity idx_) const
+    {
+        const auto &possessor = reg_.get<StatePossessor<StateIDT>>(idx_);
+        const auto &transform = reg_.get<ComponentTransform>(idx_);
+
+        const auto refs = ViewT::makeRefs(reg_, idx_);
+        ViewT view{refs};
+        visit(possessor.stateId(), [&](const auto &state_) {
+            state_.handleTransitionInto(view, TransitionData{possessor.stateId(), possessor.stateId(), transform.m_orientation});
+        });
+    }
+
+    template<typename StateIDT, IsComponentsView ViewT, typename... StatesT>
+    void StaticStateMachine<StateIDT, ViewT, StatesT...>::update(entt::registry &reg_) const
+    {
+        auto view = ViewT::makeView(reg_);
+        for (const auto &ent : view.each())
+        {
+            ViewT entityView{ent};
+            StateIDT current = entityView.template cget<StatePossessor<StateIDT>>().stateId();
+            TransitionData<StateIDT> transition{current, current, 0};
+
+            visit(current, [&](const auto &state_) {
+                state_.update(entityView);
+                transition = state_.canTransition(entityView);
+            });
+
+            while (transition.intoOrientation != 0)
+            {
+                visit(current, [&](const auto &state_) {
+                    state_.handleTransitionFrom(entityView, transition);
+                });
+
+                current = transition.intoState;
+
+                visit(current, [&](const auto &state_) {
+                    state_.handleTransitionInto(entityView, transition);
+                    transition = state_.canTransition(entityView);
+                });
+            }
+        }
+    }
+} // SM
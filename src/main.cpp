@@ -7,15 +7,21 @@
 
 #ifdef EXPERIMENTS
 #include "tests/PhysicsAttempts.hpp"  // IWYU pragma: keep
+#include "tests/StateMachineBenchmark.hpp"  // IWYU pragma: keep
+#include "tests/InputDispatchBenchmark.hpp"  // IWYU pragma: keep
+#include "tests/LoggerBenchmark.hpp"  // IWYU pragma: keep
 #endif
 
-int main(int, char**)
+int main([[maybe_unused]] int argc_, [[maybe_unused]] char** argv_)
 {
 #ifdef EXPERIMENTS
 
     try
     {
         testPhysicsAttempts();
+        benchStateMachines();
+        benchInputDispatch();
+        benchLogger();
     }
     catch (std::exception &ex_)
     {
@@ -30,11 +36,47 @@ int main(int, char**)
     try
     {
         LOG_INFO(Filesystem::getRootDirectory());
+
+        /*
+            --record <file> saves inputs of the first level, --replay <file> plays them back uncapped with hidden window
+            --headless <frames> [--level <name>] [--replay <file>] [--out <file.csv>] simulates level updates without display and reports per-system timings
+        */
+        const std::vector<std::string_view> args(argv_ + 1, argv_ + argc_);
+        const bool headless = args.size() >= 2 && args[0] == "--headless";
+        SimulationConfig simulation;
+        if (headless)
+        {
+            Application::setHeadless();
+            simulation.m_frames = static_cast<uint32_t>(std::stoul(std::string(args[1])));
+            for (size_t i = 2; i < args.size(); i += 2)
+            {
+                if (i + 1 == args.size())
+                    throw std::runtime_error(std::format("Missing value for headless argument \"{}\"", args[i]));
+
+                if (args[i] == "--level")
+                    simulation.m_level = args[i + 1];
+                else if (args[i] == "--replay")
+                    simulation.m_replay = args[i + 1];
+                else if (args[i] == "--out")
+                    simulation.m_output = args[i + 1];
+                else
+                    throw std::runtime_error(std::format("Unknown headless argument \"{}\"", args[i]));
+            }
+        }
+
         auto &app = Application::instance();
         
         app.makeLevel<BattleLevel>("Tilemaps/LevelTest.json");
         app.makeLevel<BattleLevel>("Tilemaps/Level1.json");
-        app.run();
+
+        if (headless)
+            app.simulate(simulation);
+        else if (args.size() == 2 && args[0] == "--record")
+            app.record(std::string(args[1]));
+        else if (args.size() == 2 && args[0] == "--replay")
+            app.replay(std::string(args[1]));
+        else
+            app.run();
     }
     catch (std::exception &ex_)
     {
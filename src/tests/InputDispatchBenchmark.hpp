@@ -0,0 +1,84 @@
+#pragma once
+#include "Core/InputSystem.h"
+#include "Core/Timer.h"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/*
+    Replays a stream of analog stick events through InputSystem::handleEvent
+    Stick sweeps back and forth on both axes, so most events pass deadzone and repeated value checks
+*/
+
+class BenchReactor : public InputReactor
+{
+public:
+    BenchReactor(InputSystem &input_) :
+        InputReactor(input_)
+    {
+        subscribe(GAMEPLAY_EVENTS::UP);
+        subscribe(GAMEPLAY_EVENTS::DOWN);
+        subscribe(GAMEPLAY_EVENTS::LEFT);
+        subscribe(GAMEPLAY_EVENTS::RIGHT);
+        subscribe(HUD_EVENTS::UP);
+        subscribe(HUD_EVENTS::DOWN);
+        subscribe(HUD_EVENTS::LEFT);
+        subscribe(HUD_EVENTS::RIGHT);
+        setInputEnabled();
+    }
+
+    void receiveEvents(GAMEPLAY_EVENTS, const float scale_) override
+    {
+        m_received++;
+        m_sum += scale_;
+    }
+
+    void receiveEvents(HUD_EVENTS, const float scale_) override
+    {
+        m_received++;
+        m_sum += scale_;
+    }
+
+    size_t m_received = 0;
+    float m_sum = 0.0f;
+};
+
+void benchInputDispatch()
+{
+    constexpr size_t eventCount = 1'000'000;
+    constexpr size_t reactorCount = 8;
+
+    InputSystem input;
+    std::vector<std::unique_ptr<BenchReactor>> reactors;
+    for (size_t i = 0; i < reactorCount; ++i)
+        reactors.push_back(std::make_unique<BenchReactor>(input));
+
+    std::vector<SDL_Event> events(eventCount);
+    for (size_t i = 0; i < eventCount; ++i)
+    {
+        auto &ev = events[i];
+        ev.type = SDL_EVENT_GAMEPAD_AXIS_MOTION;
+        ev.gaxis.axis = (i % 2 ? SDL_GAMEPAD_AXIS_LEFTX : SDL_GAMEPAD_AXIS_LEFTY);
+
+        // Triangle wave over the entire axis range
+        const auto phase = static_cast<int32_t>((i * 977) % 131072);
+        ev.gaxis.value = static_cast<Sint16>((phase < 65536 ? phase : 131071 - phase) - 32768);
+    }
+
+    Timer tmr;
+    tmr.begin();
+
+    for (const auto &ev : events)
+        input.handleEvent(ev);
+
+    const auto passed = tmr.getPassed();
+
+    size_t received = 0;
+    for (const auto &reactor : reactors)
+        received += reactor->m_received;
+
+    std::cout << "Input dispatch, " << eventCount << " axis events, " << reactorCount << " reactors" << std::endl;
+    std::cout << "Total, ms                  : " << static_cast<float>(passed) / 1'000'000.0f << std::endl;
+    std::cout << "Per event, ns              : " << static_cast<float>(passed) / static_cast<float>(eventCount) << std::endl;
+    std::cout << "Delivered to reactors      : " << received << std::endl;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "Core/Logger.hpp"
+#include "Core/Timer.h"
+#include <iostream>
+#include <string>
+
+/*
+    Cost of a log call on the calling thread
+    Suppressed calls are filtered at runtime, trace logs are removed entirely in release builds
+    Emitted calls are measured twice: time spent by the caller and time until everything is printed
+*/
+void benchLogger()
+{
+    constexpr size_t suppressedCount = 10'000'000;
+    constexpr size_t emittedCount = 20'000;
+
+    const auto prevLevel = Logger::getLevel();
+    const std::string name = "Benchmark";
+
+    Logger::setLevel(Logger::Level::WARNING);
+
+    Timer tmr;
+    tmr.begin();
+
+    for (size_t i = 0; i < suppressedCount; ++i)
+        LOG_INFO("Suppressed log {} of {}", i, name);
+
+    const auto suppressed = tmr.getPassed();
+
+    Logger::setLevel(Logger::Level::TRACE);
+    Logger::flush();
+
+    tmr.begin();
+
+    for (size_t i = 0; i < emittedCount; ++i)
+        LOG_INFO("Emitted log {} of {}, {}", i, name, 0.5f * static_cast<float>(i));
+
+    const auto emitted = tmr.getPassed();
+    Logger::flush();
+    const auto emittedAndPrinted = tmr.getPassed();
+
+    Logger::setLevel(prevLevel);
+
+    std::cout << "Logger, " << suppressedCount << " suppressed calls, " << emittedCount << " emitted calls" << std::endl;
+    std::cout << "Per suppressed call, ns    : " << static_cast<float>(suppressed) / static_cast<float>(suppressedCount) << std::endl;
+    std::cout << "Per emitted call, ns       : " << static_cast<float>(emitted) / static_cast<float>(emittedCount) << std::endl;
+    std::cout << "Per printed call, ns       : " << static_cast<float>(emittedAndPrinted) / static_cast<float>(emittedCount) << std::endl;
+}
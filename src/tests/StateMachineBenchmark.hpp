@@ -0,0 +1,158 @@
+#pragma once
+#include "PlayableCharacter.h"
+#include "SM/Builder.hpp"
+#include "SM/StateProperties.hpp"
+#include "SM/StaticStateMachine.hpp"
+#include "Core/Timer.h"
+#include <iostream>
+
+/*
+    Compares virtual StateMachine (regular and bucketed update) against StaticStateMachine built from the same states
+    Entities have the same set of components as the player
+*/
+
+template<bool IsStatic>
+auto makeBenchState(PlayerState id_, PlayerState next_, uint32_t duration_)
+{
+    auto updater = SM::CallBatch(
+        PlayerStateProperties::Update::MultiplyVelocity{TimelineProperty<Vector2<float>>(
+            {
+                {0, {1.f, 1.f}},
+                {3, {0.5f, 1.f}},
+                {6, {1.f, 1.f}},
+            })},
+        PlayerStateProperties::Update::AddOrientedVelocity{TimelineProperty<Vector2<float>>(
+            {
+                {0, {0.f, 0.f}},
+                {2, {2.f, 0.f}},
+                {5, {0.f, 0.f}}
+            })},
+        PlayerStateProperties::Update::SetDrag{TimelineProperty<Vector2<float>>(
+            {
+                {0, {0.05f, 0.05f}},
+                {4, {0.3f, 0.3f}},
+            })},
+        PlayerStateProperties::Update::MagnetLimit{TimelineProperty<unsigned int>(
+            {
+                {0, 10},
+                {5, 4},
+            })}
+    );
+
+    auto conditions = PlayerMake::SequentialConditions{}
+        .addCondition(std::make_unique<PlayerStateTransitions::OnGrounded>(PlayerState::FLOAT, true))
+        .addCondition(std::make_unique<PlayerStateTransitions::OnTimer>(next_, duration_))
+        .done();
+
+    if constexpr (IsStatic)
+    {
+        return PlayerMake::staticState(id_, std::move(updater), std::move(conditions),
+            SM::CallBatch(PlayerStateProperties::Pipe::MultiplyVelocity{{0.5f, 1.f}}),
+            SM::CallBatch(PlayerStateProperties::Pipe::Realign{},
+                          PlayerStateProperties::Pipe::SetGravity{{0.0f, 0.2f}},
+                          PlayerStateProperties::Pipe::SetMagnetLimit{8}));
+    }
+    else
+    {
+        return PlayerMake::state(id_, std::move(updater), std::move(conditions),
+            PlayerMake::RulePipe{}
+                .setDefaultPipe(PlayerStateProperties::Pipe::MultiplyVelocity{{0.5f, 1.f}})
+                .done(),
+            PlayerMake::RulePipe{}
+                .setDefaultPipe(PlayerStateProperties::Pipe::Realign{},
+                                PlayerStateProperties::Pipe::SetGravity{{0.0f, 0.2f}},
+                                PlayerStateProperties::Pipe::SetMagnetLimit{8})
+                .done());
+    }
+}
+
+inline void fillBenchRegistry(entt::registry &reg_, size_t count_)
+{
+    static constexpr std::array<PlayerState, 3> initialStates{PlayerState::IDLE, PlayerState::RUN, PlayerState::ATTACK_1};
+
+    for (size_t i = 0; i < count_; ++i)
+    {
+        const auto ent = reg_.create();
+        reg_.emplace<ComponentName>(ent, "BenchEntity");
+        reg_.emplace<SM::StatePossessor<PlayerState>>(ent, initialStates[i % initialStates.size()]);
+        reg_.emplace<ComponentTransform>(ent, Vector2{static_cast<int>(i), 0}, (i % 2 ? Orientation::RIGHT : Orientation::LEFT));
+        reg_.emplace<ComponentPhysical>(ent);
+        reg_.emplace<ComponentObstacleFallthrough>(ent);
+        reg_.emplace<WorldPosition>(ent);
+        reg_.emplace<ComponentAnimationRenderable>(ent);
+        reg_.emplace<InputResolver>(ent);
+        reg_.emplace<ComponentDynamicCameraTarget>(ent);
+        reg_.emplace<ComponentChildParticles>(ent);
+    }
+}
+
+template<typename MachineT, typename UpdateT>
+uint64_t runStateMachineBench(MachineT &machine_, entt::registry &reg_, size_t frames_, UpdateT &&update_)
+{
+    for (const auto &idx : reg_.view<SM::StatePossessor<PlayerState>>())
+        machine_.init(reg_, idx);
+
+    Timer tmr;
+    tmr.begin();
+
+    for (size_t i = 0; i < frames_; ++i)
+        update_(machine_, reg_);
+
+    return tmr.getPassed();
+}
+
+inline size_t countStateMismatches(entt::registry &lhsReg_, entt::registry &rhsReg_)
+{
+    size_t mismatches = 0;
+    auto lhsView = lhsReg_.view<SM::StatePossessor<PlayerState>>();
+    auto rhsView = rhsReg_.view<SM::StatePossessor<PlayerState>>();
+    for (auto lit = lhsView.begin(), rit = rhsView.begin(); lit != lhsView.end() && rit != rhsView.end(); ++lit, ++rit)
+    {
+        const auto &lhs = lhsReg_.get<SM::StatePossessor<PlayerState>>(*lit);
+        const auto &rhs = rhsReg_.get<SM::StatePossessor<PlayerState>>(*rit);
+        if (lhs.stateId() != rhs.stateId() || lhs.framesInState() != rhs.framesInState())
+            mismatches++;
+    }
+
+    return mismatches;
+}
+
+void benchStateMachines()
+{
+    constexpr size_t entityCount = 5000;
+    constexpr size_t frameCount = 600;
+
+    SM::StateMachine<PlayerState, PlayerView> dynamicMachine;
+    // Updaters only write components of their own entity and timeline lookups don't mutate anything
+    dynamicMachine.addState(makeBenchState<false>(PlayerState::IDLE, PlayerState::RUN, 7), SM::UpdateLocality::ENTITY_LOCAL);
+    dynamicMachine.addState(makeBenchState<false>(PlayerState::RUN, PlayerState::ATTACK_1, 11), SM::UpdateLocality::ENTITY_LOCAL);
+    dynamicMachine.addState(makeBenchState<false>(PlayerState::ATTACK_1, PlayerState::IDLE, 13), SM::UpdateLocality::ENTITY_LOCAL);
+
+    auto staticMachine = PlayerMake::staticMachine(
+        makeBenchState<true>(PlayerState::IDLE, PlayerState::RUN, 7),
+        makeBenchState<true>(PlayerState::RUN, PlayerState::ATTACK_1, 11),
+        makeBenchState<true>(PlayerState::ATTACK_1, PlayerState::IDLE, 13)
+    );
+
+    entt::registry dynamicReg;
+    entt::registry bucketedReg;
+    entt::registry staticReg;
+    fillBenchRegistry(dynamicReg, entityCount);
+    fillBenchRegistry(bucketedReg, entityCount);
+    fillBenchRegistry(staticReg, entityCount);
+
+    const auto dynamicTime = runStateMachineBench(dynamicMachine, dynamicReg, frameCount, [](auto &machine_, auto &reg_) { machine_.update(reg_); });
+    SM::StateBuckets buckets;
+    const auto bucketedTime = runStateMachineBench(dynamicMachine, bucketedReg, frameCount, [&buckets](auto &machine_, auto &reg_) { machine_.updateBucketed(reg_, buckets); });
+    const auto staticTime = runStateMachineBench(staticMachine, staticReg, frameCount, [](auto &machine_, auto &reg_) { machine_.update(reg_); });
+
+    const auto perEntity = [&](uint64_t time_) {
+        return static_cast<float>(time_) / static_cast<float>(entityCount * frameCount);
+    };
+
+    std::cout << "State machine, " << entityCount << " entities, " << frameCount << " frames" << std::endl;
+    std::cout << "Dynamic state machine, ms / ns per entity : " << static_cast<float>(dynamicTime) / 1'000'000.0f << " / " << perEntity(dynamicTime) << std::endl;
+    std::cout << "Bucketed state machine, ms / ns per entity: " << static_cast<float>(bucketedTime) / 1'000'000.0f << " / " << perEntity(bucketedTime) << std::endl;
+    std::cout << "Static state machine, ms / ns per entity  : " << static_cast<float>(staticTime) / 1'000'000.0f << " / " << perEntity(staticTime) << std::endl;
+    std::cout << "Mismatched entities, bucketed / static    : " << countStateMismatches(dynamicReg, bucketedReg) << " / " << countStateMismatches(dynamicReg, staticReg) << std::endl;
+}